@@ -0,0 +1,357 @@
+/*
+ * Benchmarks of the noise functions.
+ *
+ * This program measures how long it takes to evaluate the noise in each dimension and with each
+ * data type, through every entry point of the library: scalar calls with random and coherent (grid)
+ * access patterns, simplex and periodic noise, analytical derivatives, grid fills (including the
+ * fixed-point ones with integer output), array evaluation, animated fields, the multithreaded
+ * engine, asynchronous chunks, and fused noise graphs. Each measurement is repeated several times
+ * and the fastest run is reported, which filters out most of the noise caused by other processes on
+ * the machine.
+ *
+ * The results are printed to the standard output either as CSV (default) or as JSON, so that they
+ * can be collected by other tools:
+ *
+ *   db_perlin_bench [--format csv|json] [--samples N] [--repeats N] [--threads N] [--filter TEXT]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define DB_PERLIN_IMPL
+#include "../db_perlin.hpp"
+#include "../db_perlin_engine.hpp"
+#include "../db_perlin_anim.hpp"
+#include "../db_perlin_graph.hpp"
+#include "../db_perlin_async.hpp"
+
+struct Options {
+    std::string format = "csv";
+    std::string filter = "";
+    long long samples = 1 << 20;
+    int repeats = 5;
+    unsigned threads = std::thread::hardware_concurrency();
+};
+
+struct Result {
+    std::string name;    // The entry point being measured.
+    std::string type;    // The data type of the coordinates.
+    int dimensions;      // The number of dimensions of the noise.
+    std::string access;  // The access pattern: random or grid.
+    unsigned threads;    // The number of threads generating the noise.
+    long long samples;   // The number of samples per run.
+    double seconds;      // The duration of the fastest run.
+};
+
+// Prevents the compiler from discarding the computations whose results are never used.
+static volatile double sink = 0.0;
+
+template<typename T>
+static auto consume(std::vector<T> const& values) -> void {
+    auto sum = 0.0;
+    for (auto i = std::size_t { 0 }; i < values.size(); i += 61) {
+        sum += double(values[i]);
+    }
+    sink = sink + sum;
+}
+
+static auto measure(int repeats, std::function<void()> const& run) -> double {
+    // The first run warms up the caches (and, for the engine, the worker threads).
+    run();
+
+    auto best = 1e300;
+    for (auto r = 0; r < repeats; ++r) {
+        auto const start = std::chrono::steady_clock::now();
+        run();
+        auto const stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+template<typename T>
+static auto type_name() -> char const*;
+
+template<>
+auto type_name<float>() -> char const* { return "float"; }
+
+template<>
+auto type_name<double>() -> char const* { return "double"; }
+
+// Picks grid dimensions with roughly the requested number of samples in total.
+static auto grid_side(long long samples, int dimensions) -> int {
+    auto side = 1;
+    while (true) {
+        auto total = 1LL;
+        for (auto d = 0; d < dimensions; ++d) {
+            total *= side + 1;
+        }
+        if (total > samples) {
+            return side;
+        }
+        ++side;
+    }
+}
+
+template<typename T>
+static auto bench_type(Options const& options, db::noise_engine& engine, std::vector<Result>& results) -> void {
+    auto const n = options.samples;
+    auto const step = T(1.0) / T(64.0);
+
+    // Random coordinates spread over the whole period of the noise, so consecutive samples
+    // almost never share a lattice cell.
+    std::mt19937 rng { 12345 };
+    std::uniform_real_distribution<T> distribution { T(0.0), T(256.0) };
+
+    std::vector<T> xs(n), ys(n), zs(n), ws(n), out(n);
+    for (auto i = 0LL; i < n; ++i) {
+        xs[i] = distribution(rng);
+        ys[i] = distribution(rng);
+        zs[i] = distribution(rng);
+        ws[i] = distribution(rng);
+    }
+
+    auto add = [&](char const* name, int dimensions, char const* access, unsigned threads, long long samples, std::function<void()> const& run) {
+        auto const label = std::string { name } + "/" + type_name<T>() + "/" + std::to_string(dimensions) + "d/" + access;
+        if (!options.filter.empty() && label.find(options.filter) == std::string::npos) {
+            return;
+        }
+        auto const seconds = measure(options.repeats, run);
+        results.push_back(Result { name, type_name<T>(), dimensions, access, threads, samples, seconds });
+        consume(out);
+    };
+
+    add("scalar", 1, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin(xs[i]);
+    });
+    add("scalar", 2, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin(xs[i], ys[i]);
+    });
+    add("scalar", 3, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin(xs[i], ys[i], zs[i]);
+    });
+
+    add("simplex", 1, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::simplex(xs[i]);
+    });
+    add("simplex", 2, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::simplex(xs[i], ys[i]);
+    });
+    add("simplex", 3, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::simplex(xs[i], ys[i], zs[i]);
+    });
+    add("simplex", 4, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::simplex(xs[i], ys[i], zs[i], ws[i]);
+    });
+
+    // Periods that are not powers of two, so the lattice coordinates need an actual modulo.
+    add("periodic", 2, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin_periodic(xs[i], ys[i], 100, 60);
+    });
+    add("periodic", 3, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin_periodic(xs[i], ys[i], zs[i], 100, 60, 30);
+    });
+
+    add("derivative", 1, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin_d(xs[i]).dx;
+    });
+    add("derivative", 2, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin_d(xs[i], ys[i]).dx;
+    });
+    add("derivative", 3, "random", 1, n, [&] {
+        for (auto i = 0LL; i < n; ++i) out[i] = db::perlin_d(xs[i], ys[i], zs[i]).dx;
+    });
+
+    add("array", 1, "random", 1, n, [&] { db::perlin_n(xs.data(), out.data(), n); });
+    add("array", 2, "random", 1, n, [&] { db::perlin_n(xs.data(), ys.data(), out.data(), n); });
+    add("array", 3, "random", 1, n, [&] { db::perlin_n(xs.data(), ys.data(), zs.data(), out.data(), n); });
+
+    auto const side1 = int(n);
+    auto const side2 = grid_side(n, 2);
+    auto const side3 = grid_side(n, 3);
+
+    add("scalar", 1, "grid", 1, side1, [&] {
+        for (auto i = 0; i < side1; ++i) out[i] = db::perlin(T(i) * step);
+    });
+    add("scalar", 2, "grid", 1, static_cast<long long>(side2) * side2, [&] {
+        for (auto j = 0; j < side2; ++j)
+            for (auto i = 0; i < side2; ++i)
+                out[j * side2 + i] = db::perlin(T(i) * step, T(j) * step);
+    });
+    add("scalar", 3, "grid", 1, static_cast<long long>(side3) * side3 * side3, [&] {
+        for (auto k = 0; k < side3; ++k)
+            for (auto j = 0; j < side3; ++j)
+                for (auto i = 0; i < side3; ++i)
+                    out[(k * side3 + j) * side3 + i] = db::perlin(T(i) * step, T(j) * step, T(k) * step);
+    });
+
+    add("simplex", 3, "grid", 1, static_cast<long long>(side3) * side3 * side3, [&] {
+        for (auto k = 0; k < side3; ++k)
+            for (auto j = 0; j < side3; ++j)
+                for (auto i = 0; i < side3; ++i)
+                    out[(k * side3 + j) * side3 + i] = db::simplex(T(i) * step, T(j) * step, T(k) * step);
+    });
+
+    add("fill", 2, "grid", 1, static_cast<long long>(side2) * side2, [&] {
+        db::perlin_fill_2d(out.data(), side2, side2, T(0.0), T(0.0), step);
+    });
+    add("fill", 3, "grid", 1, static_cast<long long>(side3) * side3 * side3, [&] {
+        db::perlin_fill_3d(out.data(), side3, side3, side3, T(0.0), T(0.0), T(0.0), step);
+    });
+
+    // Consecutive frames of an animation, which only differ in the z-coordinate.
+    db::animated_field<T> field { side2, side2 };
+    field.set_view(T(0.0), T(0.0), step);
+    auto time = T(0.0);
+    add("animated", 3, "frames", 1, static_cast<long long>(side2) * side2, [&] {
+        field.evaluate(time, out.data());
+        time += step;
+    });
+
+    db::noise_region<T> region {};
+    region.width = side2;
+    region.height = side2;
+    region.scale = step;
+
+    db::noise_engine single { 1 };
+    add("engine", 2, "grid", 1, static_cast<long long>(side2) * side2, [&] { single.generate(region, out.data()); });
+    add("engine", 2, "grid", engine.thread_count(), static_cast<long long>(side2) * side2, [&] { engine.generate(region, out.data()); });
+
+    // The same region requested as 4x4 chunks from the background threads, waiting for all of them.
+    db::chunk_generator<T> chunks { engine.thread_count() };
+    add("chunks", 2, "grid", chunks.thread_count(), static_cast<long long>(side2) * side2, [&] {
+        std::vector<typename db::chunk_generator<T>::ticket> tickets;
+        for (auto j = 0; j < 4; ++j) {
+            for (auto i = 0; i < 4; ++i) {
+                auto chunk = region;
+                chunk.width = side2 / 4;
+                chunk.height = side2 / 4;
+                chunk.x0 = T(i * chunk.width) * step;
+                chunk.y0 = T(j * chunk.height) * step;
+                tickets.push_back(chunks.submit(chunk));
+            }
+        }
+        for (auto& ticket : tickets) {
+            out[0] = ticket.get().samples[0];
+        }
+    });
+
+    // A composition evaluated as a single kernel: 4 octaves warped by 2 octaves along each axis.
+    namespace g = db::graph;
+    auto const offset = g::fbm(g::perlin<T>(), db::fractal<T> { 2 });
+    auto const warped = g::warp(g::fbm(g::perlin<T>(), db::fractal<T> { 4 }), offset, g::translate(offset, T(5.2), T(1.3)), T(4.0));
+    add("graph", 2, "grid", 1, static_cast<long long>(side2) * side2, [&] {
+        g::fill_2d(warped, out.data(), side2, side2, T(0.0), T(0.0), step);
+    });
+    add("graph", 2, "grid", engine.thread_count(), static_cast<long long>(side2) * side2, [&] {
+        g::generate(engine, warped, out.data(), side2, side2, T(0.0), T(0.0), step);
+    });
+}
+
+// The fixed-point fills write integers directly, so they are measured on their own, with the
+// output type in place of the type of the coordinates.
+static auto bench_fixed(Options const& options, std::vector<Result>& results) -> void {
+    auto const side2 = grid_side(options.samples, 2);
+    auto const side3 = grid_side(options.samples, 3);
+    auto const step = 1.0 / 64.0;
+
+    std::vector<std::uint8_t> out8(options.samples);
+    std::vector<std::uint16_t> out16(options.samples);
+
+    auto add = [&](char const* type, int dimensions, long long samples, std::function<void()> const& run) {
+        auto const label = std::string { "fill/" } + type + "/" + std::to_string(dimensions) + "d/grid";
+        if (!options.filter.empty() && label.find(options.filter) == std::string::npos) {
+            return;
+        }
+        auto const seconds = measure(options.repeats, run);
+        results.push_back(Result { "fill", type, dimensions, "grid", 1, samples, seconds });
+        sink = sink + out8[0] + out16[0];
+    };
+
+    add("uint8", 2, static_cast<long long>(side2) * side2, [&] {
+        db::perlin_fill_2d_u8(out8.data(), side2, side2, 0.0, 0.0, step);
+    });
+    add("uint16", 2, static_cast<long long>(side2) * side2, [&] {
+        db::perlin_fill_2d_u16(out16.data(), side2, side2, 0.0, 0.0, step);
+    });
+    add("uint8", 3, static_cast<long long>(side3) * side3 * side3, [&] {
+        db::perlin_fill_3d_u8(out8.data(), side3, side3, side3, 0.0, 0.0, 0.0, step);
+    });
+    add("uint16", 3, static_cast<long long>(side3) * side3 * side3, [&] {
+        db::perlin_fill_3d_u16(out16.data(), side3, side3, side3, 0.0, 0.0, 0.0, step);
+    });
+}
+
+static auto print_csv(std::vector<Result> const& results) -> void {
+    std::printf("name,type,dimensions,access,threads,samples,ns_per_sample,samples_per_sec\n");
+    for (auto const& r : results) {
+        std::printf("%s,%s,%d,%s,%u,%lld,%.3f,%.0f\n",
+            r.name.c_str(), r.type.c_str(), r.dimensions, r.access.c_str(), r.threads, r.samples,
+            r.seconds * 1e9 / double(r.samples), double(r.samples) / r.seconds);
+    }
+}
+
+static auto print_json(std::vector<Result> const& results) -> void {
+    std::printf("[\n");
+    for (auto i = std::size_t { 0 }; i < results.size(); ++i) {
+        auto const& r = results[i];
+        std::printf("  {\"name\": \"%s\", \"type\": \"%s\", \"dimensions\": %d, \"access\": \"%s\", \"threads\": %u, "
+                    "\"samples\": %lld, \"ns_per_sample\": %.3f, \"samples_per_sec\": %.0f}%s\n",
+            r.name.c_str(), r.type.c_str(), r.dimensions, r.access.c_str(), r.threads, r.samples,
+            r.seconds * 1e9 / double(r.samples), double(r.samples) / r.seconds,
+            (i + 1 < results.size()) ? "," : "");
+    }
+    std::printf("]\n");
+}
+
+static auto parse(int argc, char** argv, Options& options) -> bool {
+    for (auto i = 1; i < argc; ++i) {
+        auto const arg = std::string { argv[i] };
+        auto const has_value = i + 1 < argc;
+
+        if (arg == "--format" && has_value) {
+            options.format = argv[++i];
+        } else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--samples" && has_value) {
+            options.samples = std::atoll(argv[++i]);
+        } else if (arg == "--repeats" && has_value) {
+            options.repeats = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && has_value) {
+            options.threads = unsigned(std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return (options.format == "csv" || options.format == "json") && options.samples > 0 && options.repeats > 0;
+}
+
+auto main(int argc, char** argv) -> int {
+    auto options = Options {};
+    if (!parse(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--format csv|json] [--samples N] [--repeats N] [--threads N] [--filter TEXT]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    db::noise_engine engine { options.threads };
+
+    auto results = std::vector<Result> {};
+    bench_type<float>(options, engine, results);
+    bench_type<double>(options, engine, results);
+    bench_fixed(options, results);
+
+    if (options.format == "json") {
+        print_json(results);
+    } else {
+        print_csv(results);
+    }
+}
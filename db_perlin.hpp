@@ -25,258 +25,3642 @@
  * Compile that file together with the rest of the program, and all other files may then simply
  * include this header without any additional work.
  *
+ * Alternatively, define `DB_PERLIN_HEADER_ONLY` before including this header in every source file
+ * that uses it. The implementation is then compiled wherever it is needed, which also allows the
+ * `constexpr` functions to be evaluated at compile time (at the cost of longer compilation).
+ *
  * To generate noise, simply use the `perlin` function under `db` namespace. There are three
  * overloads accounting for each dimension, so pass 1-3 arguments to generate noise in the
  * corresponding number of dimensions.
  *
+ * The `simplex` function has the same interface as `perlin` with an additional 4D overload. It is
+ * Ken Perlin's later simplex noise, which samples 4 corners instead of 8 in 3D (and 5 instead of 16
+ * in 4D), has no axis-aligned artifacts, and is cheaper in higher dimensions. Its values are not
+ * the same as those of `perlin`, so the two cannot be swapped in an existing scene without
+ * changing its look.
+ *
  * The implementation has template specializations to work with either floats or doubles,
  * depending on the desired accuracy.
+ *
+ * When noise is needed over a whole regular grid (e.g., to fill an image or a heightmap),
+ * prefer `perlin_fill_2d` and `perlin_fill_3d` over calling `perlin` for every sample. They
+ * write the samples into a caller-provided buffer in row-major order (x varies fastest), and
+ * reuse the lattice hashes and fade values shared by neighbouring samples. The sample at grid
+ * position (i, j, k) is exactly `perlin(x0 + i * step, y0 + j * step, z0 + k * step)`.
+ *
+ * For images and heightmaps stored as integers, `perlin_fill_2d_u8` (and the `_u16` and 3D variants)
+ * evaluate the grid in fixed-point arithmetic and write the samples directly as 8-bit or 16-bit
+ * unsigned integers, mapping [-1, 1] onto the full range of the type. Being computed with integers
+ * only, the output is exactly the same on every platform. Compared to rounding the `double` noise,
+ * the samples differ by at most 1 for 8-bit and 2 for 16-bit output (the error of the noise itself
+ * stays below 7e-5, measured over millions of random samples). Any finite origin and step are
+ * accepted, as the lattice repeats every 256 units anyway. These fills exist for the exactness of
+ * their output rather than for speed: per sample, they are somewhat slower than the `float` fills.
+ *
+ * The `perlin_d` functions return the value of the noise together with its analytical partial
+ * derivatives (e.g., to compute normals), at a fraction of the cost of finite differences.
+ *
+ * Fractal noise is available through `fbm`, `ridged`, and `turbulence`, which sum up several
+ * octaves of noise in a single call. Each octave is still a separate evaluation of the noise, so
+ * the cost grows linearly with the number of octaves. The octaves are described either inline
+ * (the number of octaves, lacunarity and gain) or by a `fractal` object that holds precomputed
+ * per-octave frequencies and amplitudes. `fbm` stays within the range of a single octave, whereas
+ * `ridged` and `turbulence` produce values in the range of [0, 1] (or [-1, 1] with a negative
+ * gain). `fbm_fill_2d` and `fbm_fill_3d` are the grid-filling counterparts of `fbm`.
+ *
+ * Textures that must tile seamlessly may use `perlin_periodic` and `fbm_periodic`, which repeat
+ * with an integer period of any size along each axis. A single tile may then be generated once
+ * and repeated instead of evaluating the noise over the whole surface.
+ *
+ * When only an approximation of `fbm` is needed, the octaves may be evaluated progressively, from
+ * the lowest frequency to the highest, stopping as soon as the remaining octaves cannot change the
+ * outcome. Every octave is bounded by the largest magnitude of the noise (0.5 in 1D, 1.0 in 2D,
+ * and 1.0364 in 3D) times its amplitude. `fbm_progressive` stops once the result is within the
+ * given tolerance of `fbm`, whereas `fbm_classify` stops once it is known which of the given
+ * thresholds `fbm` exceeds; its result is always the same as comparing the full `fbm` with them.
+ *
+ * All of the free functions use the same built-in permutation table, so they always produce the
+ * same noise. To get a different instance of the noise, create a `perlin_generator` from a seed:
+ * it generates its own permutation table and provides the same functions as member functions.
+ *
+ * Noise over small fixed grids may be baked into tables at compile time with `bake_perlin_1d`
+ * (through `_3d`) and `bake_fbm_1d` (through `_3d`), which produce a `baked_noise` table. Declare
+ * the table as `static constexpr` to have it stored in the read-only data of the program.
+ *
+ * For arbitrary coordinates, `perlin_n` evaluates the noise over arrays of 1-3 coordinates
+ * and writes one result per sample. For floats, the samples are processed with SIMD kernels
+ * (SSE2, AVX2, or NEON), which produce the same results as the scalar path.
+ *
+ * To find out where the noise is sampled, define `DB_PERLIN_PROFILE` (in every source file, like
+ * `DB_PERLIN_HEADER_ONLY`). The library then counts the samples evaluated on each thread, by type
+ * and dimension, times its batch functions, and counts the hits and misses of the tile cache.
+ * `profile_totals` and `profile_threads` return snapshots of the counters, and
+ * `profile_write_trace` writes the timed batches, together with any `profile_zone` spans, as a
+ * Chrome trace. Without the definition, none of this is compiled in.
+ */
+
+#ifndef DB_PERLIN_HPP
+#define DB_PERLIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(DB_PERLIN_HEADER_ONLY) && !defined(DB_PERLIN_IMPL)
+#define DB_PERLIN_IMPL
+#endif
+
+// In header-only mode every source file compiles the implementation, so the definitions of
+// functions that are not templates must be marked inline to avoid duplicate symbols.
+#ifdef DB_PERLIN_HEADER_ONLY
+#define DB_PERLIN_INLINE inline
+#else
+#define DB_PERLIN_INLINE
+#endif
+
+namespace db {
+    template<typename T>
+    constexpr auto perlin(T x) -> T;
+
+    template<typename T>
+    constexpr auto perlin(T x, T y) -> T;
+
+    template<typename T>
+    constexpr auto perlin(T x, T y, T z) -> T;
+
+    template<typename T>
+    constexpr auto simplex(T x) -> T;
+
+    template<typename T>
+    constexpr auto simplex(T x, T y) -> T;
+
+    template<typename T>
+    constexpr auto simplex(T x, T y, T z) -> T;
+
+    template<typename T>
+    constexpr auto simplex(T x, T y, T z, T w) -> T;
+
+    // Noise that repeats itself every `px` units along the x-axis (and `py`, `pz` along the others),
+    // so a tile of the given size may be repeated without seams. The periods are integers of any
+    // size (periods below 1 are treated as 1). With a period of 256 the noise is the same as `perlin`.
+    template<typename T>
+    constexpr auto perlin_periodic(T x, int px) -> T;
+
+    template<typename T>
+    constexpr auto perlin_periodic(T x, T y, int px, int py) -> T;
+
+    template<typename T>
+    constexpr auto perlin_periodic(T x, T y, T z, int px, int py, int pz) -> T;
+
+    // The value of the noise together with its partial derivatives along each axis. The
+    // derivatives along the axes that the noise does not have are always zero.
+    template<typename T>
+    struct noise_gradient {
+        T value;
+        T dx;
+        T dy;
+        T dz;
+    };
+
+    template<typename T>
+    constexpr auto perlin_d(T x) -> noise_gradient<T>;
+
+    template<typename T>
+    constexpr auto perlin_d(T x, T y) -> noise_gradient<T>;
+
+    template<typename T>
+    constexpr auto perlin_d(T x, T y, T z) -> noise_gradient<T>;
+
+    template<typename T>
+    auto perlin_fill_2d(T* out, int width, int height, T x0, T y0, T step) -> void;
+
+    template<typename T>
+    auto perlin_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step) -> void;
+
+    // Grid fills computed in fixed-point arithmetic, which write the noise directly as unsigned
+    // integers: the range of [-1, 1] is mapped onto the full range of the output type. The output
+    // is the same on every platform for any finite origin and step.
+    auto perlin_fill_2d_u8(std::uint8_t* out, int width, int height, double x0, double y0, double step) -> void;
+    auto perlin_fill_2d_u16(std::uint16_t* out, int width, int height, double x0, double y0, double step) -> void;
+
+    auto perlin_fill_3d_u8(std::uint8_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) -> void;
+    auto perlin_fill_3d_u16(std::uint16_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) -> void;
+
+    // A permutation table defines a particular instance of the noise. Its second half mirrors
+    // the first one, so that lattice coordinates may be offset without wrapping. The table is
+    // also kept with 32-bit entries, which is the format expected by SIMD gather instructions.
+    struct permutation {
+        unsigned char p[512];
+        int p32[512];
+    };
+
+    // The maximum number of octaves that may be summed up by the fractal functions.
+    constexpr int fractal_max_octaves = 32;
+
+    // Per-octave frequencies and amplitudes of fractal noise. Each octave has `lacunarity` times
+    // the frequency and `gain` times the amplitude of the previous one. The tables are computed
+    // once on construction, so it is best to build the parameters once and reuse them.
+    // The sum of the octaves is normalized by the total magnitude of their amplitudes, so that a
+    // negative gain (which flips the sign of every other octave) never leads to a division by zero.
+    template<typename T>
+    struct fractal {
+        int octaves;
+        T frequency[fractal_max_octaves];
+        T amplitude[fractal_max_octaves];
+        T total_amplitude;
+
+        constexpr explicit fractal(int octaves_, T lacunarity = T(2.0), T gain = T(0.5))
+            : octaves { (octaves_ < 1) ? 1 : (octaves_ > fractal_max_octaves) ? fractal_max_octaves : octaves_ }
+            , frequency {}
+            , amplitude {}
+            , total_amplitude { T(0.0) } {
+            T f = T(1.0);
+            T a = T(1.0);
+            for (int i = 0; i < this->octaves; ++i) {
+                frequency[i] = f;
+                amplitude[i] = a;
+                total_amplitude += (a < T(0.0)) ? -a : a;
+                f *= lacunarity;
+                a *= gain;
+            }
+        }
+    };
+
+    template<typename T>
+    constexpr auto fbm(T x, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, T z, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto fbm(T x, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, T z, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto ridged(T x, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, T z, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto ridged(T x, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, T z, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto turbulence(T x, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, T z, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto turbulence(T x, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, T z, int octaves, T lacunarity = T(2.0), T gain = T(0.5)) -> T;
+
+    // Fractal noise whose octaves repeat every `px` (`py`, `pz`) units, as `perlin_periodic` does. An
+    // octave of frequency `f` has a period of `px * f` in its own coordinates, which is rounded to
+    // an integer, so the sum is only seamless when the frequencies are integers (e.g., with the
+    // default lacunarity of 2).
+    template<typename T>
+    constexpr auto fbm_periodic(T x, int px, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto fbm_periodic(T x, T y, int px, int py, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto fbm_periodic(T x, T y, T z, int px, int py, int pz, fractal<T> const& f) -> T;
+
+    template<typename T>
+    constexpr auto fbm_progressive(T x, fractal<T> const& f, T tolerance) -> T;
+
+    template<typename T>
+    constexpr auto fbm_progressive(T x, T y, fractal<T> const& f, T tolerance) -> T;
+
+    template<typename T>
+    constexpr auto fbm_progressive(T x, T y, T z, fractal<T> const& f, T tolerance) -> T;
+
+    // Returns the number of thresholds that `fbm` exceeds at the given point (e.g., the index of a
+    // biome or a band of heights when the thresholds are sorted in ascending order).
+    template<typename T>
+    constexpr auto fbm_classify(T x, fractal<T> const& f, T const* thresholds, int count) -> int;
+
+    template<typename T>
+    constexpr auto fbm_classify(T x, T y, fractal<T> const& f, T const* thresholds, int count) -> int;
+
+    template<typename T>
+    constexpr auto fbm_classify(T x, T y, T z, fractal<T> const& f, T const* thresholds, int count) -> int;
+
+    template<typename T>
+    auto fbm_fill_2d(T* out, int width, int height, T x0, T y0, T step, fractal<T> const& f) -> void;
+
+    template<typename T>
+    auto fbm_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step, fractal<T> const& f) -> void;
+
+    // A table of noise samples over a regular grid of `Width * Height * Depth` points, stored in
+    // row-major order (x varies fastest). Tables are meant to be baked at compile time by the
+    // `bake_*` functions, and then looked up by the indices of the samples.
+    template<typename T, int Width, int Height = 1, int Depth = 1>
+    struct baked_noise {
+        T data[Width * Height * Depth];
+
+        constexpr auto operator()(int i, int j = 0, int k = 0) const -> T {
+            return data[(k * Height + j) * Width + i];
+        }
+    };
+
+    template<typename T, int Width>
+    constexpr auto bake_perlin_1d(T x0, T step) -> baked_noise<T, Width>;
+
+    template<typename T, int Width, int Height>
+    constexpr auto bake_perlin_2d(T x0, T y0, T step) -> baked_noise<T, Width, Height>;
+
+    template<typename T, int Width, int Height, int Depth>
+    constexpr auto bake_perlin_3d(T x0, T y0, T z0, T step) -> baked_noise<T, Width, Height, Depth>;
+
+    template<typename T, int Width>
+    constexpr auto bake_fbm_1d(T x0, T step, fractal<T> const& f) -> baked_noise<T, Width>;
+
+    template<typename T, int Width, int Height>
+    constexpr auto bake_fbm_2d(T x0, T y0, T step, fractal<T> const& f) -> baked_noise<T, Width, Height>;
+
+    template<typename T, int Width, int Height, int Depth>
+    constexpr auto bake_fbm_3d(T x0, T y0, T z0, T step, fractal<T> const& f) -> baked_noise<T, Width, Height, Depth>;
+
+    template<typename T>
+    auto perlin_n(T const* xs, T* out, std::size_t n) -> void;
+
+    template<typename T>
+    auto perlin_n(T const* xs, T const* ys, T* out, std::size_t n) -> void;
+
+    template<typename T>
+    auto perlin_n(T const* xs, T const* ys, T const* zs, T* out, std::size_t n) -> void;
+
+    // An instance of the noise with its own permutation table, generated from a seed. The free
+    // functions are equivalent to the member functions of a generator with the built-in table.
+    // Generators are immutable, so a single instance may be shared between threads freely.
+    class perlin_generator {
+    public:
+        explicit perlin_generator(std::uint64_t seed);
+
+        auto seed() const -> std::uint64_t;
+        auto table() const -> permutation const&;
+
+        template<typename T>
+        auto perlin(T x) const -> T;
+
+        template<typename T>
+        auto perlin(T x, T y) const -> T;
+
+        template<typename T>
+        auto perlin(T x, T y, T z) const -> T;
+
+        template<typename T>
+        auto simplex(T x) const -> T;
+
+        template<typename T>
+        auto simplex(T x, T y) const -> T;
+
+        template<typename T>
+        auto simplex(T x, T y, T z) const -> T;
+
+        template<typename T>
+        auto simplex(T x, T y, T z, T w) const -> T;
+
+        template<typename T>
+        auto perlin_periodic(T x, int px) const -> T;
+
+        template<typename T>
+        auto perlin_periodic(T x, T y, int px, int py) const -> T;
+
+        template<typename T>
+        auto perlin_periodic(T x, T y, T z, int px, int py, int pz) const -> T;
+
+        template<typename T>
+        auto perlin_d(T x) const -> noise_gradient<T>;
+
+        template<typename T>
+        auto perlin_d(T x, T y) const -> noise_gradient<T>;
+
+        template<typename T>
+        auto perlin_d(T x, T y, T z) const -> noise_gradient<T>;
+
+        template<typename T>
+        auto fbm(T x, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto fbm(T x, T y, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto fbm(T x, T y, T z, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto ridged(T x, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto ridged(T x, T y, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto ridged(T x, T y, T z, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto turbulence(T x, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto turbulence(T x, T y, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto turbulence(T x, T y, T z, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto fbm_periodic(T x, int px, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto fbm_periodic(T x, T y, int px, int py, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto fbm_periodic(T x, T y, T z, int px, int py, int pz, fractal<T> const& f) const -> T;
+
+        template<typename T>
+        auto fbm_progressive(T x, fractal<T> const& f, T tolerance) const -> T;
+
+        template<typename T>
+        auto fbm_progressive(T x, T y, fractal<T> const& f, T tolerance) const -> T;
+
+        template<typename T>
+        auto fbm_progressive(T x, T y, T z, fractal<T> const& f, T tolerance) const -> T;
+
+        template<typename T>
+        auto fbm_classify(T x, fractal<T> const& f, T const* thresholds, int count) const -> int;
+
+        template<typename T>
+        auto fbm_classify(T x, T y, fractal<T> const& f, T const* thresholds, int count) const -> int;
+
+        template<typename T>
+        auto fbm_classify(T x, T y, T z, fractal<T> const& f, T const* thresholds, int count) const -> int;
+
+        template<typename T>
+        auto perlin_fill_2d(T* out, int width, int height, T x0, T y0, T step) const -> void;
+
+        template<typename T>
+        auto perlin_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step) const -> void;
+
+        auto perlin_fill_2d_u8(std::uint8_t* out, int width, int height, double x0, double y0, double step) const -> void;
+        auto perlin_fill_2d_u16(std::uint16_t* out, int width, int height, double x0, double y0, double step) const -> void;
+
+        auto perlin_fill_3d_u8(std::uint8_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) const -> void;
+        auto perlin_fill_3d_u16(std::uint16_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) const -> void;
+
+        template<typename T>
+        auto fbm_fill_2d(T* out, int width, int height, T x0, T y0, T step, fractal<T> const& f) const -> void;
+
+        template<typename T>
+        auto fbm_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step, fractal<T> const& f) const -> void;
+
+        template<typename T>
+        auto perlin_n(T const* xs, T* out, std::size_t n) const -> void;
+
+        template<typename T>
+        auto perlin_n(T const* xs, T const* ys, T* out, std::size_t n) const -> void;
+
+        template<typename T>
+        auto perlin_n(T const* xs, T const* ys, T const* zs, T* out, std::size_t n) const -> void;
+
+    private:
+        std::uint64_t m_seed;
+        permutation m_permutation;
+    };
+}
+
+#ifdef DB_PERLIN_PROFILE
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace db {
+    // Counters of the noise evaluated by the library, indexed by the type of the coordinates
+    // (0 for `float`, 1 for `double`) and the number of dimensions minus one. Fixed-point fills
+    // are counted as `double`, as that is the type of their coordinates.
+    struct profile_stats {
+        std::uint64_t scalar_samples[2][4];
+        std::uint64_t batch_samples[2][4];
+        std::uint64_t batch_calls[2][4];
+        std::uint64_t batch_nanoseconds[2][4];
+        std::uint64_t cache_hits;
+        std::uint64_t cache_misses;
+        std::uint64_t cache_evictions;
+    };
+
+    struct profile_thread {
+        std::uint32_t id;   // The same as the thread's `tid` in the trace.
+        std::string name;
+        profile_stats stats;
+    };
+
+    // Names the calling thread in snapshots and traces (e.g., after the system that runs on it).
+    auto profile_set_thread_name(char const* name) -> void;
+
+    // Sums up the counters of all threads, including the ones that have already exited.
+    auto profile_totals() -> profile_stats;
+
+    // Returns the counters of every running thread that has evaluated the noise.
+    auto profile_threads() -> std::vector<profile_thread>;
+
+    // Clears all counters and trace events.
+    auto profile_reset() -> void;
+
+    // Writes the recorded batches and zones in the Chrome trace event format (JSON), which may be
+    // opened in chrome://tracing or https://ui.perfetto.dev.
+    auto profile_write_trace(std::FILE* file) -> bool;
+    auto profile_write_trace(char const* path) -> bool;
+
+    // Records a span in the trace, e.g., around the code of a system that samples the noise. The
+    // name must outlive the trace, so it is usually a string literal.
+    class profile_zone {
+    public:
+        explicit profile_zone(char const* name);
+        ~profile_zone();
+
+        profile_zone(profile_zone const&) = delete;
+        auto operator=(profile_zone const&) -> profile_zone& = delete;
+
+    private:
+        char const* m_name;
+        std::uint64_t m_start;
+    };
+}
+
+#endif // DB_PERLIN_PROFILE
+
+#ifdef DB_PERLIN_IMPL
+
+#include <cmath>
+
+/*
+ * Vectorized kernels are used by `perlin_n` for floats. SSE2 and NEON are selected at compile time
+ * (they are part of the baseline instruction sets of x86-64 and AArch64, respectively), whereas AVX2
+ * is compiled in whenever the compiler supports target attributes and is selected at runtime based
+ * on what the processor supports. Define `DB_PERLIN_NO_SIMD` to always use the scalar path.
  */
 
-#ifndef DB_PERLIN_HPP
-#define DB_PERLIN_HPP
+#if !defined(DB_PERLIN_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DB_PERLIN_SIMD_AVX2 1
+#endif
+
+#if !defined(DB_PERLIN_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define DB_PERLIN_SIMD_SSE2 1
+#endif
+
+#if !defined(DB_PERLIN_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define DB_PERLIN_SIMD_NEON 1
+#endif
+
+#if DB_PERLIN_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+#if DB_PERLIN_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if DB_PERLIN_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+ * Instrumentation is compiled in when `DB_PERLIN_PROFILE` is defined, and expands to nothing
+ * otherwise. Every thread that evaluates the noise gets its own block of counters, which only
+ * that thread ever writes to, so counting a scalar sample costs a thread-local increment. Batch
+ * functions (grid fills and array evaluation) are timed as a whole and recorded as trace events.
+ *
+ * The scalar functions are `constexpr`, so they may only count samples outside of constant
+ * evaluation, which is detected with `__builtin_is_constant_evaluated`. Compilers without it
+ * leave the scalar counters at zero.
+ */
+
+#ifdef DB_PERLIN_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define DB_PERLIN_PROFILE_SCALAR_ENABLED 1
+#endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1925
+#define DB_PERLIN_PROFILE_SCALAR_ENABLED 1
+#endif
+
+#ifdef DB_PERLIN_PROFILE_SCALAR_ENABLED
+#define DB_PERLIN_PROFILE_SCALAR(T, dimensions) \
+    if (!__builtin_is_constant_evaluated()) { ::db::profile_count_scalar(::db::profile_type_index<T>(), dimensions); }
+#else
+#define DB_PERLIN_PROFILE_SCALAR(T, dimensions)
+#endif
+
+#define DB_PERLIN_PROFILE_BATCH(T, name, dimensions, samples) \
+    ::db::profile_batch const db_perlin_profile_batch { name, ::db::profile_type_index<T>(), dimensions, static_cast<std::uint64_t>(samples) }
+
+#define DB_PERLIN_PROFILE_ZONE(name) \
+    ::db::profile_zone const db_perlin_profile_zone { name }
+
+#define DB_PERLIN_PROFILE_CACHE(hits, misses, evictions) \
+    ::db::profile_count_cache(hits, misses, evictions)
+
+namespace db {
+    // At most this many events are kept per thread; the counters keep counting past it.
+    constexpr std::size_t profile_max_events = std::size_t(1) << 18;
+
+    struct profile_event {
+        char const* name;
+        std::uint64_t start;    // Nanoseconds since the start of the profile.
+        std::uint64_t duration;
+        std::uint64_t samples;
+        bool batch;             // Whether the event is a batch or a zone.
+    };
+
+    // Counters are only written by their own thread, with a relaxed load and store rather than a
+    // read-modify-write operation, so that an increment stays cheap while snapshots taken from
+    // other threads are still free of data races.
+    struct profile_counter {
+        std::atomic<std::uint64_t> value { 0 };
+
+        auto add(std::uint64_t n) -> void {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        auto get() const -> std::uint64_t {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    struct profile_thread_data {
+        std::uint32_t id = 0;
+        profile_counter scalar_samples[2][4];
+        profile_counter batch_samples[2][4];
+        profile_counter batch_calls[2][4];
+        profile_counter batch_nanoseconds[2][4];
+        profile_counter cache_hits;
+        profile_counter cache_misses;
+        profile_counter cache_evictions;
+
+        std::mutex mutex;  // Guards the name and the events.
+        std::string name;
+        std::vector<profile_event> events;
+    };
+
+    // Threads that have exited leave their counters and events behind in the registry.
+    struct profile_retired_thread {
+        std::uint32_t id;
+        std::string name;
+        std::vector<profile_event> events;
+    };
+
+    struct profile_registry {
+        std::mutex mutex;
+        std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+        std::uint32_t next_id = 1;
+        std::vector<profile_thread_data*> threads;
+        std::vector<profile_retired_thread> retired;
+        profile_stats retired_stats {};
+    };
+
+    // The registry is never destroyed, as threads may still exit after static destructors have run.
+    DB_PERLIN_INLINE auto profile_registry_instance() -> profile_registry& {
+        static profile_registry* const registry = new profile_registry {};
+        return *registry;
+    }
+
+    DB_PERLIN_INLINE auto profile_now() -> std::uint64_t {
+        auto const elapsed = std::chrono::steady_clock::now() - profile_registry_instance().epoch;
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    template<typename T>
+    constexpr auto profile_type_index() -> int {
+        return sizeof(T) == sizeof(float) ? 0 : 1;
+    }
+
+    // The slot is a plain pointer, so that the fast path does not go through the initialization
+    // guard of a thread-local object.
+    DB_PERLIN_INLINE auto profile_thread_slot() -> profile_thread_data*& {
+        static thread_local profile_thread_data* slot = nullptr;
+        return slot;
+    }
+
+    DB_PERLIN_INLINE auto profile_accumulate(profile_stats& into, profile_thread_data const& from) -> void {
+        for (int t = 0; t < 2; ++t) {
+            for (int d = 0; d < 4; ++d) {
+                into.scalar_samples[t][d] += from.scalar_samples[t][d].get();
+                into.batch_samples[t][d] += from.batch_samples[t][d].get();
+                into.batch_calls[t][d] += from.batch_calls[t][d].get();
+                into.batch_nanoseconds[t][d] += from.batch_nanoseconds[t][d].get();
+            }
+        }
+        into.cache_hits += from.cache_hits.get();
+        into.cache_misses += from.cache_misses.get();
+        into.cache_evictions += from.cache_evictions.get();
+    }
+
+    // Moves the counters and events of an exiting thread into the registry.
+    struct profile_thread_guard {
+        profile_thread_data* data = nullptr;
+
+        ~profile_thread_guard() {
+            if (data == nullptr) {
+                return;
+            }
+
+            profile_registry& registry = profile_registry_instance();
+            std::lock_guard<std::mutex> lock { registry.mutex };
+
+            profile_accumulate(registry.retired_stats, *data);
+            registry.retired.push_back(profile_retired_thread { data->id, std::move(data->name), std::move(data->events) });
+            for (auto it = registry.threads.begin(); it != registry.threads.end(); ++it) {
+                if (*it == data) {
+                    registry.threads.erase(it);
+                    break;
+                }
+            }
+
+            profile_thread_slot() = nullptr;
+            delete data;
+        }
+    };
+
+    DB_PERLIN_INLINE auto profile_this_thread() -> profile_thread_data& {
+        profile_thread_data*& slot = profile_thread_slot();
+        if (slot == nullptr) {
+            static thread_local profile_thread_guard guard {};
+
+            auto* const data = new profile_thread_data {};
+            profile_registry& registry = profile_registry_instance();
+            {
+                std::lock_guard<std::mutex> lock { registry.mutex };
+                data->id = registry.next_id++;
+                registry.threads.push_back(data);
+            }
+
+            guard.data = data;
+            slot = data;
+        }
+        return *slot;
+    }
+
+    DB_PERLIN_INLINE auto profile_count_scalar(int type, int dimensions) -> void {
+        profile_this_thread().scalar_samples[type][dimensions - 1].add(1);
+    }
+
+    DB_PERLIN_INLINE auto profile_count_cache(int hits, int misses, int evictions) -> void {
+        profile_thread_data& data = profile_this_thread();
+        data.cache_hits.add(std::uint64_t(hits));
+        data.cache_misses.add(std::uint64_t(misses));
+        data.cache_evictions.add(std::uint64_t(evictions));
+    }
+
+    DB_PERLIN_INLINE auto profile_record(profile_thread_data& data, profile_event const& event) -> void {
+        std::lock_guard<std::mutex> lock { data.mutex };
+        if (data.events.size() < profile_max_events) {
+            data.events.push_back(event);
+        }
+    }
+
+    // Times a call of a batch function, and counts the samples it produces.
+    class profile_batch {
+    public:
+        profile_batch(char const* name, int type, int dimensions, std::uint64_t samples)
+            : m_name { name }
+            , m_type { type }
+            , m_dimensions { dimensions }
+            , m_samples { samples }
+            , m_start { profile_now() } {}
+
+        ~profile_batch() {
+            std::uint64_t const duration = profile_now() - m_start;
+
+            profile_thread_data& data = profile_this_thread();
+            data.batch_samples[m_type][m_dimensions - 1].add(m_samples);
+            data.batch_calls[m_type][m_dimensions - 1].add(1);
+            data.batch_nanoseconds[m_type][m_dimensions - 1].add(duration);
+            profile_record(data, profile_event { m_name, m_start, duration, m_samples, true });
+        }
+
+        profile_batch(profile_batch const&) = delete;
+        auto operator=(profile_batch const&) -> profile_batch& = delete;
+
+    private:
+        char const* m_name;
+        int m_type;
+        int m_dimensions;
+        std::uint64_t m_samples;
+        std::uint64_t m_start;
+    };
+
+    DB_PERLIN_INLINE profile_zone::profile_zone(char const* name)
+        : m_name { name }
+        , m_start { profile_now() } {}
+
+    DB_PERLIN_INLINE profile_zone::~profile_zone() {
+        std::uint64_t const duration = profile_now() - m_start;
+        profile_record(profile_this_thread(), profile_event { m_name, m_start, duration, 0, false });
+    }
+
+    DB_PERLIN_INLINE auto profile_set_thread_name(char const* name) -> void {
+        profile_thread_data& data = profile_this_thread();
+        std::lock_guard<std::mutex> lock { data.mutex };
+        data.name = name;
+    }
+
+    DB_PERLIN_INLINE auto profile_totals() -> profile_stats {
+        profile_registry& registry = profile_registry_instance();
+        std::lock_guard<std::mutex> lock { registry.mutex };
+
+        profile_stats result = registry.retired_stats;
+        for (profile_thread_data const* data : registry.threads) {
+            profile_accumulate(result, *data);
+        }
+        return result;
+    }
+
+    DB_PERLIN_INLINE auto profile_threads() -> std::vector<profile_thread> {
+        profile_registry& registry = profile_registry_instance();
+        std::lock_guard<std::mutex> lock { registry.mutex };
+
+        std::vector<profile_thread> result {};
+        for (profile_thread_data* data : registry.threads) {
+            profile_thread thread { data->id, {}, {} };
+            {
+                std::lock_guard<std::mutex> data_lock { data->mutex };
+                thread.name = data->name;
+            }
+            profile_accumulate(thread.stats, *data);
+            result.push_back(std::move(thread));
+        }
+        return result;
+    }
+
+    // Counts that are being added while the counters are cleared may survive the reset, as the
+    // counters are not updated atomically.
+    DB_PERLIN_INLINE auto profile_reset() -> void {
+        profile_registry& registry = profile_registry_instance();
+        std::lock_guard<std::mutex> lock { registry.mutex };
+
+        registry.retired_stats = profile_stats {};
+        registry.retired.clear();
+        for (profile_thread_data* data : registry.threads) {
+            for (int t = 0; t < 2; ++t) {
+                for (int d = 0; d < 4; ++d) {
+                    data->scalar_samples[t][d].value.store(0, std::memory_order_relaxed);
+                    data->batch_samples[t][d].value.store(0, std::memory_order_relaxed);
+                    data->batch_calls[t][d].value.store(0, std::memory_order_relaxed);
+                    data->batch_nanoseconds[t][d].value.store(0, std::memory_order_relaxed);
+                }
+            }
+            data->cache_hits.value.store(0, std::memory_order_relaxed);
+            data->cache_misses.value.store(0, std::memory_order_relaxed);
+            data->cache_evictions.value.store(0, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> data_lock { data->mutex };
+            data->events.clear();
+        }
+    }
+
+    DB_PERLIN_INLINE auto profile_write_string(std::FILE* file, char const* text) -> void {
+        std::fputc('"', file);
+        for (char const* c = text; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                std::fputc('\\', file);
+                std::fputc(*c, file);
+            } else if (static_cast<unsigned char>(*c) < 0x20) {
+                std::fprintf(file, "\\u%04x", static_cast<unsigned>(*c));
+            } else {
+                std::fputc(*c, file);
+            }
+        }
+        std::fputc('"', file);
+    }
+
+    DB_PERLIN_INLINE auto profile_write_thread(std::FILE* file, std::uint32_t id, std::string const& name, std::vector<profile_event> const& events, bool& first) -> void {
+        if (!name.empty()) {
+            std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",", id);
+            profile_write_string(file, name.c_str());
+            std::fputs("}}", file);
+            first = false;
+        }
+
+        // Timestamps are in microseconds.
+        for (profile_event const& event : events) {
+            std::fprintf(file, "%s\n{\"name\":", first ? "" : ",");
+            profile_write_string(file, event.name);
+            std::fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                event.batch ? "batch" : "zone", id, double(event.start) / 1000.0, double(event.duration) / 1000.0);
+            if (event.batch) {
+                std::fprintf(file, ",\"args\":{\"samples\":%llu}", static_cast<unsigned long long>(event.samples));
+            }
+            std::fputc('}', file);
+            first = false;
+        }
+    }
+
+    DB_PERLIN_INLINE auto profile_write_trace(std::FILE* file) -> bool {
+        profile_registry& registry = profile_registry_instance();
+        std::lock_guard<std::mutex> lock { registry.mutex };
+
+        bool first = true;
+        std::fputs("{\"traceEvents\":[", file);
+        for (profile_retired_thread const& thread : registry.retired) {
+            profile_write_thread(file, thread.id, thread.name, thread.events, first);
+        }
+        for (profile_thread_data* data : registry.threads) {
+            std::lock_guard<std::mutex> data_lock { data->mutex };
+            profile_write_thread(file, data->id, data->name, data->events, first);
+        }
+        std::fputs("\n]}\n", file);
+
+        return std::ferror(file) == 0;
+    }
+
+    DB_PERLIN_INLINE auto profile_write_trace(char const* path) -> bool {
+        std::FILE* const file = std::fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+
+        bool const written = profile_write_trace(file);
+        return (std::fclose(file) == 0) && written;
+    }
+}
+
+#else
+
+#define DB_PERLIN_PROFILE_SCALAR(T, dimensions)
+#define DB_PERLIN_PROFILE_BATCH(T, name, dimensions, samples)
+#define DB_PERLIN_PROFILE_ZONE(name)
+#define DB_PERLIN_PROFILE_CACHE(hits, misses, evictions)
+
+#endif // DB_PERLIN_PROFILE
+
+/*
+ * The implementation was based on this article:
+ * - https://flafla2.github.io/2014/08/09/perlinnoise.html
+ *
+ * A reference implementation in Java by Ken Perlin, the author of the algorithm:
+ * - https://mrl.cs.nyu.edu/~perlin/noise/
+ *
+ * Here are some alternative implementations that were used as inspirations:
+ * - https://github.com/nothings/stb/blob/master/stb_perlin.h
+ * - https://github.com/stegu/perlin-noise/blob/master/src/noise1234.c
+ */
+
+namespace db {
+    // Permutation table, the second half is a mirror of the first half.
+    static constexpr unsigned char p[512] = {
+        0x97, 0xA0, 0x89, 0x5B, 0x5A, 0x0F, 0x83, 0x0D, 0xC9, 0x5F, 0x60, 0x35, 0xC2, 0xE9, 0x07, 0xE1,
+        0x8C, 0x24, 0x67, 0x1E, 0x45, 0x8E, 0x08, 0x63, 0x25, 0xF0, 0x15, 0x0A, 0x17, 0xBE, 0x06, 0x94,
+        0xF7, 0x78, 0xEA, 0x4B, 0x00, 0x1A, 0xC5, 0x3E, 0x5E, 0xFC, 0xDB, 0xCB, 0x75, 0x23, 0x0B, 0x20,
+        0x39, 0xB1, 0x21, 0x58, 0xED, 0x95, 0x38, 0x57, 0xAE, 0x14, 0x7D, 0x88, 0xAB, 0xA8, 0x44, 0xAF,
+        0x4A, 0xA5, 0x47, 0x86, 0x8B, 0x30, 0x1B, 0xA6, 0x4D, 0x92, 0x9E, 0xE7, 0x53, 0x6F, 0xE5, 0x7A,
+        0x3C, 0xD3, 0x85, 0xE6, 0xDC, 0x69, 0x5C, 0x29, 0x37, 0x2E, 0xF5, 0x28, 0xF4, 0x66, 0x8F, 0x36,
+        0x41, 0x19, 0x3F, 0xA1, 0x01, 0xD8, 0x50, 0x49, 0xD1, 0x4C, 0x84, 0xBB, 0xD0, 0x59, 0x12, 0xA9,
+        0xC8, 0xC4, 0x87, 0x82, 0x74, 0xBC, 0x9F, 0x56, 0xA4, 0x64, 0x6D, 0xC6, 0xAD, 0xBA, 0x03, 0x40,
+        0x34, 0xD9, 0xE2, 0xFA, 0x7C, 0x7B, 0x05, 0xCA, 0x26, 0x93, 0x76, 0x7E, 0xFF, 0x52, 0x55, 0xD4,
+        0xCF, 0xCE, 0x3B, 0xE3, 0x2F, 0x10, 0x3A, 0x11, 0xB6, 0xBD, 0x1C, 0x2A, 0xDF, 0xB7, 0xAA, 0xD5,
+        0x77, 0xF8, 0x98, 0x02, 0x2C, 0x9A, 0xA3, 0x46, 0xDD, 0x99, 0x65, 0x9B, 0xA7, 0x2B, 0xAC, 0x09,
+        0x81, 0x16, 0x27, 0xFD, 0x13, 0x62, 0x6C, 0x6E, 0x4F, 0x71, 0xE0, 0xE8, 0xB2, 0xB9, 0x70, 0x68,
+        0xDA, 0xF6, 0x61, 0xE4, 0xFB, 0x22, 0xF2, 0xC1, 0xEE, 0xD2, 0x90, 0x0C, 0xBF, 0xB3, 0xA2, 0xF1,
+        0x51, 0x33, 0x91, 0xEB, 0xF9, 0x0E, 0xEF, 0x6B, 0x31, 0xC0, 0xD6, 0x1F, 0xB5, 0xC7, 0x6A, 0x9D,
+        0xB8, 0x54, 0xCC, 0xB0, 0x73, 0x79, 0x32, 0x2D, 0x7F, 0x04, 0x96, 0xFE, 0x8A, 0xEC, 0xCD, 0x5D,
+        0xDE, 0x72, 0x43, 0x1D, 0x18, 0x48, 0xF3, 0x8D, 0x80, 0xC3, 0x4E, 0x42, 0xD7, 0x3D, 0x9C, 0xB4,
+
+        0x97, 0xA0, 0x89, 0x5B, 0x5A, 0x0F, 0x83, 0x0D, 0xC9, 0x5F, 0x60, 0x35, 0xC2, 0xE9, 0x07, 0xE1,
+        0x8C, 0x24, 0x67, 0x1E, 0x45, 0x8E, 0x08, 0x63, 0x25, 0xF0, 0x15, 0x0A, 0x17, 0xBE, 0x06, 0x94,
+        0xF7, 0x78, 0xEA, 0x4B, 0x00, 0x1A, 0xC5, 0x3E, 0x5E, 0xFC, 0xDB, 0xCB, 0x75, 0x23, 0x0B, 0x20,
+        0x39, 0xB1, 0x21, 0x58, 0xED, 0x95, 0x38, 0x57, 0xAE, 0x14, 0x7D, 0x88, 0xAB, 0xA8, 0x44, 0xAF,
+        0x4A, 0xA5, 0x47, 0x86, 0x8B, 0x30, 0x1B, 0xA6, 0x4D, 0x92, 0x9E, 0xE7, 0x53, 0x6F, 0xE5, 0x7A,
+        0x3C, 0xD3, 0x85, 0xE6, 0xDC, 0x69, 0x5C, 0x29, 0x37, 0x2E, 0xF5, 0x28, 0xF4, 0x66, 0x8F, 0x36,
+        0x41, 0x19, 0x3F, 0xA1, 0x01, 0xD8, 0x50, 0x49, 0xD1, 0x4C, 0x84, 0xBB, 0xD0, 0x59, 0x12, 0xA9,
+        0xC8, 0xC4, 0x87, 0x82, 0x74, 0xBC, 0x9F, 0x56, 0xA4, 0x64, 0x6D, 0xC6, 0xAD, 0xBA, 0x03, 0x40,
+        0x34, 0xD9, 0xE2, 0xFA, 0x7C, 0x7B, 0x05, 0xCA, 0x26, 0x93, 0x76, 0x7E, 0xFF, 0x52, 0x55, 0xD4,
+        0xCF, 0xCE, 0x3B, 0xE3, 0x2F, 0x10, 0x3A, 0x11, 0xB6, 0xBD, 0x1C, 0x2A, 0xDF, 0xB7, 0xAA, 0xD5,
+        0x77, 0xF8, 0x98, 0x02, 0x2C, 0x9A, 0xA3, 0x46, 0xDD, 0x99, 0x65, 0x9B, 0xA7, 0x2B, 0xAC, 0x09,
+        0x81, 0x16, 0x27, 0xFD, 0x13, 0x62, 0x6C, 0x6E, 0x4F, 0x71, 0xE0, 0xE8, 0xB2, 0xB9, 0x70, 0x68,
+        0xDA, 0xF6, 0x61, 0xE4, 0xFB, 0x22, 0xF2, 0xC1, 0xEE, 0xD2, 0x90, 0x0C, 0xBF, 0xB3, 0xA2, 0xF1,
+        0x51, 0x33, 0x91, 0xEB, 0xF9, 0x0E, 0xEF, 0x6B, 0x31, 0xC0, 0xD6, 0x1F, 0xB5, 0xC7, 0x6A, 0x9D,
+        0xB8, 0x54, 0xCC, 0xB0, 0x73, 0x79, 0x32, 0x2D, 0x7F, 0x04, 0x96, 0xFE, 0x8A, 0xEC, 0xCD, 0x5D,
+        0xDE, 0x72, 0x43, 0x1D, 0x18, 0x48, 0xF3, 0x8D, 0x80, 0xC3, 0x4E, 0x42, 0xD7, 0x3D, 0x9C, 0xB4,
+    };
+
+    static constexpr auto make_default_permutation() -> permutation {
+        permutation result {};
+        for (int i = 0; i < 512; ++i) {
+            result.p[i] = p[i];
+            result.p32[i] = p[i];
+        }
+        return result;
+    }
+
+    // The permutation used by all of the free functions.
+    static constexpr permutation default_permutation = make_default_permutation();
+
+    template<typename T>
+    static constexpr auto lerp(T a, T b, T t) -> T {
+        return a + t * (b - a);
+    }
+
+    template<typename T>
+    static constexpr auto floor(T x) -> int {
+        auto const xi = int(x);
+        return (x < T(xi)) ? xi - 1 : xi;
+    }
+
+    template<typename T>
+    static constexpr auto fade(T t) -> T {
+        return t * t * t * (t * (t * T(6.0) - T(15.0)) + T(10.0));
+    }
+
+    template<typename T>
+    static constexpr auto fade_derivative(T t) -> T {
+        return T(30.0) * t * t * (t * (t - T(2.0)) + T(1.0));
+    }
+
+    template<typename T>
+    static constexpr auto dot_grad(int hash, T xf) -> T {
+        // In 1D case, the gradient may be either 1 or -1.
+        // The distance vector is the input offset (relative to the smallest bound).
+        return (hash & 0x1) ? xf : -xf;
+    }
+
+    template<typename T>
+    static constexpr auto dot_grad(int hash, T xf, T yf) -> T {
+        // In 2D case, the gradient may be any of 8 direction vectors pointing to the
+        // edges of a unit-square. The distance vector is the input offset (relative to
+        // the smallest bound).
+        //
+        //   0: ( 1,  1)   1: ( 1,  0)   2: ( 1, -1)   3: ( 0, -1)
+        //   4: (-1, -1)   5: (-1,  0)   6: (-1,  1)   7: ( 0,  1)
+        //
+        // The components are selected with bit tests rather than a table or a switch, so
+        // that the same logic maps directly onto the SIMD kernels below.
+        int const h = hash & 0x7;
+        T const a = ((h & 0x3) == 0x3) ? T(0.0) : ((h & 0x4) ? -xf : xf);
+        T const b = ((h & 0x3) == 0x1) ? T(0.0) : (((h + 0x2) & 0x4) ? -yf : yf);
+        return a + b;
+    }
+
+    template<typename T>
+    static constexpr auto dot_grad(int hash, T xf, T yf, T zf) -> T {
+        // In 3D case, the gradient may be any of 12 direction vectors pointing to the edges
+        // of a unit-cube (rounded to 16 with duplications). The distance vector is the input
+        // offset (relative to the smallest bound).
+        //
+        //   0: ( 1,  1,  0)   1: (-1,  1,  0)   2: ( 1, -1,  0)   3: (-1, -1,  0)
+        //   4: ( 1,  0,  1)   5: (-1,  0,  1)   6: ( 1,  0, -1)   7: (-1,  0, -1)
+        //   8: ( 0,  1,  1)   9: ( 0, -1,  1)   A: ( 0,  1, -1)   B: ( 0, -1, -1)
+        //   C: ( 1,  1,  0)   D: ( 0, -1,  1)   E: (-1,  1,  0)   F: ( 0, -1, -1)
+        //
+        // This is the branchless formulation from Ken Perlin's reference implementation.
+        int const h = hash & 0xF;
+        T const a = (h < 0x8) ? xf : yf;
+        T const b = (h < 0x4) ? yf : ((h == 0xC || h == 0xE) ? xf : zf);
+        return ((h & 0x1) ? -a : a) + ((h & 0x2) ? -b : b);
+    }
+
+    template<typename T>
+    static constexpr auto perlin_scalar(permutation const& perm, T x) -> T {
+        // Left coordinate of the unit-line that contains the input.
+        int const xi0 = floor(x);
+
+        // Input location in the unit-line.
+        T const xf0 = x - T(xi0);
+        T const xf1 = xf0 - T(1.0);
+
+        // Wrap to range 0-255.
+        int const xi = xi0 & 0xFF;
+
+        // Apply the fade function to the location.
+        T const u = fade(xf0);
+
+        // Generate hash values for each point of the unit-line.
+        int const h0 = perm.p[xi + 0];
+        int const h1 = perm.p[xi + 1];
+
+        // Linearly interpolate between dot products of each gradient with its distance to the input location.
+        return lerp(dot_grad(h0, xf0), dot_grad(h1, xf1), u);
+    }
+
+    template<typename T>
+    static constexpr auto perlin_scalar(permutation const& perm, T x, T y) -> T {
+        // Top-left coordinates of the unit-square.
+        int const xi0 = floor(x);
+        int const yi0 = floor(y);
+
+        // Input location in the unit-square.
+        T const xf0 = x - T(xi0);
+        T const yf0 = y - T(yi0);
+        T const xf1 = xf0 - T(1.0);
+        T const yf1 = yf0 - T(1.0);
+
+        // Wrap to range 0-255.
+        int const xi = xi0 & 0xFF;
+        int const yi = yi0 & 0xFF;
+
+        // Apply the fade function to the location.
+        T const u = fade(xf0);
+        T const v = fade(yf0);
+
+        // Generate hash values for each point of the unit-square.
+        int const h00 = perm.p[perm.p[xi + 0] + yi + 0];
+        int const h01 = perm.p[perm.p[xi + 0] + yi + 1];
+        int const h10 = perm.p[perm.p[xi + 1] + yi + 0];
+        int const h11 = perm.p[perm.p[xi + 1] + yi + 1];
+
+        // Linearly interpolate between dot products of each gradient with its distance to the input location.
+        T const x1 = lerp(dot_grad(h00, xf0, yf0), dot_grad(h10, xf1, yf0), u);
+        T const x2 = lerp(dot_grad(h01, xf0, yf1), dot_grad(h11, xf1, yf1), u);
+        return lerp(x1, x2, v);
+    }
+
+    template<typename T>
+    static constexpr auto perlin_scalar(permutation const& perm, T x, T y, T z) -> T {
+        // Top-left coordinates of the unit-cube.
+        int const xi0 = floor(x);
+        int const yi0 = floor(y);
+        int const zi0 = floor(z);
+
+        // Input location in the unit-cube.
+        T const xf0 = x - T(xi0);
+        T const yf0 = y - T(yi0);
+        T const zf0 = z - T(zi0);
+        T const xf1 = xf0 - T(1.0);
+        T const yf1 = yf0 - T(1.0);
+        T const zf1 = zf0 - T(1.0);
+
+        // Wrap to range 0-255.
+        int const xi = xi0 & 0xFF;
+        int const yi = yi0 & 0xFF;
+        int const zi = zi0 & 0xFF;
+
+        // Apply the fade function to the location.
+        T const u = fade(xf0);
+        T const v = fade(yf0);
+        T const w = fade(zf0);
+
+        // Generate hash values for each point of the unit-cube.
+        int const h000 = perm.p[perm.p[perm.p[xi + 0] + yi + 0] + zi + 0];
+        int const h001 = perm.p[perm.p[perm.p[xi + 0] + yi + 0] + zi + 1];
+        int const h010 = perm.p[perm.p[perm.p[xi + 0] + yi + 1] + zi + 0];
+        int const h011 = perm.p[perm.p[perm.p[xi + 0] + yi + 1] + zi + 1];
+        int const h100 = perm.p[perm.p[perm.p[xi + 1] + yi + 0] + zi + 0];
+        int const h101 = perm.p[perm.p[perm.p[xi + 1] + yi + 0] + zi + 1];
+        int const h110 = perm.p[perm.p[perm.p[xi + 1] + yi + 1] + zi + 0];
+        int const h111 = perm.p[perm.p[perm.p[xi + 1] + yi + 1] + zi + 1];
+
+        // Linearly interpolate between dot products of each gradient with its distance to the input location.
+        T const x11 = lerp(dot_grad(h000, xf0, yf0, zf0), dot_grad(h100, xf1, yf0, zf0), u);
+        T const x12 = lerp(dot_grad(h010, xf0, yf1, zf0), dot_grad(h110, xf1, yf1, zf0), u);
+        T const x21 = lerp(dot_grad(h001, xf0, yf0, zf1), dot_grad(h101, xf1, yf0, zf1), u);
+        T const x22 = lerp(dot_grad(h011, xf0, yf1, zf1), dot_grad(h111, xf1, yf1, zf1), u);
+
+        T const y1 = lerp(x11, x12, v);
+        T const y2 = lerp(x21, x22, v);
+
+        return lerp(y1, y2, w);
+    }
+
+    // Every scalar evaluation of the noise goes through these, so that it is counted by the
+    // profiler; batch functions call the kernels above directly.
+    template<typename T>
+    static constexpr auto perlin(permutation const& perm, T x) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 1);
+        return perlin_scalar(perm, x);
+    }
+
+    template<typename T>
+    static constexpr auto perlin(permutation const& perm, T x, T y) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 2);
+        return perlin_scalar(perm, x, y);
+    }
+
+    template<typename T>
+    static constexpr auto perlin(permutation const& perm, T x, T y, T z) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 3);
+        return perlin_scalar(perm, x, y, z);
+    }
+
+    template<typename T>
+    constexpr auto perlin(T x) -> T {
+        return perlin(default_permutation, x);
+    }
+
+    template<typename T>
+    constexpr auto perlin(T x, T y) -> T {
+        return perlin(default_permutation, x, y);
+    }
+
+    template<typename T>
+    constexpr auto perlin(T x, T y, T z) -> T {
+        return perlin(default_permutation, x, y, z);
+    }
+
+    // Periodic noise wraps the coordinates of the lattice around the period before they are hashed,
+    // so the corners on either side of a period boundary share their gradients. The permutation
+    // table only has 256 entries, so the wrapped coordinates are then folded into the range 0-255:
+    // the low byte is kept as is, and every higher byte is mixed into it through the table. This
+    // way, coordinates below 256 are hashed exactly as in `perlin`, while larger periods do not
+    // repeat every 256 units (two coordinates that differ by a multiple of 256 always differ in
+    // their higher bytes, and so in their folded values).
+
+    static constexpr auto wrap_period(int i, int period) -> int {
+        int const m = i % period;
+        return (m < 0) ? m + period : m;
+    }
+
+    static constexpr auto clamp_period(int period) -> int {
+        return (period < 1) ? 1 : period;
+    }
+
+    static constexpr auto fold_period(permutation const& perm, int i) -> int {
+        int folded = i & 0xFF;
+        for (i >>= 8; i != 0; i >>= 8) {
+            folded = perm.p[folded + (i & 0xFF)];
+        }
+        return folded;
+    }
+
+    template<typename T>
+    static constexpr auto perlin_periodic(permutation const& perm, T x, int px) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 1);
+        px = clamp_period(px);
+
+        int const xi0 = floor(x);
+        T const xf0 = x - T(xi0);
+        T const xf1 = xf0 - T(1.0);
+
+        // Wrap both ends of the unit-line around the period separately, then fold them to range 0-255.
+        int const xw = wrap_period(xi0, px);
+        int const xa = fold_period(perm, xw);
+        int const xb = fold_period(perm, (xw + 1 == px) ? 0 : xw + 1);
+
+        T const u = fade(xf0);
+
+        int const h0 = perm.p[xa];
+        int const h1 = perm.p[xb];
+
+        return lerp(dot_grad(h0, xf0), dot_grad(h1, xf1), u);
+    }
+
+    template<typename T>
+    static constexpr auto perlin_periodic(permutation const& perm, T x, T y, int px, int py) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 2);
+        px = clamp_period(px);
+        py = clamp_period(py);
+
+        int const xi0 = floor(x);
+        int const yi0 = floor(y);
+        T const xf0 = x - T(xi0);
+        T const yf0 = y - T(yi0);
+        T const xf1 = xf0 - T(1.0);
+        T const yf1 = yf0 - T(1.0);
+
+        int const xw = wrap_period(xi0, px);
+        int const yw = wrap_period(yi0, py);
+        int const xa = fold_period(perm, xw);
+        int const ya = fold_period(perm, yw);
+        int const xb = fold_period(perm, (xw + 1 == px) ? 0 : xw + 1);
+        int const yb = fold_period(perm, (yw + 1 == py) ? 0 : yw + 1);
+
+        T const u = fade(xf0);
+        T const v = fade(yf0);
+
+        int const h00 = perm.p[perm.p[xa] + ya];
+        int const h01 = perm.p[perm.p[xa] + yb];
+        int const h10 = perm.p[perm.p[xb] + ya];
+        int const h11 = perm.p[perm.p[xb] + yb];
+
+        T const x1 = lerp(dot_grad(h00, xf0, yf0), dot_grad(h10, xf1, yf0), u);
+        T const x2 = lerp(dot_grad(h01, xf0, yf1), dot_grad(h11, xf1, yf1), u);
+        return lerp(x1, x2, v);
+    }
+
+    template<typename T>
+    static constexpr auto perlin_periodic(permutation const& perm, T x, T y, T z, int px, int py, int pz) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 3);
+        px = clamp_period(px);
+        py = clamp_period(py);
+        pz = clamp_period(pz);
+
+        int const xi0 = floor(x);
+        int const yi0 = floor(y);
+        int const zi0 = floor(z);
+        T const xf0 = x - T(xi0);
+        T const yf0 = y - T(yi0);
+        T const zf0 = z - T(zi0);
+        T const xf1 = xf0 - T(1.0);
+        T const yf1 = yf0 - T(1.0);
+        T const zf1 = zf0 - T(1.0);
+
+        int const xw = wrap_period(xi0, px);
+        int const yw = wrap_period(yi0, py);
+        int const zw = wrap_period(zi0, pz);
+        int const xa = fold_period(perm, xw);
+        int const ya = fold_period(perm, yw);
+        int const za = fold_period(perm, zw);
+        int const xb = fold_period(perm, (xw + 1 == px) ? 0 : xw + 1);
+        int const yb = fold_period(perm, (yw + 1 == py) ? 0 : yw + 1);
+        int const zb = fold_period(perm, (zw + 1 == pz) ? 0 : zw + 1);
+
+        T const u = fade(xf0);
+        T const v = fade(yf0);
+        T const w = fade(zf0);
+
+        int const h000 = perm.p[perm.p[perm.p[xa] + ya] + za];
+        int const h001 = perm.p[perm.p[perm.p[xa] + ya] + zb];
+        int const h010 = perm.p[perm.p[perm.p[xa] + yb] + za];
+        int const h011 = perm.p[perm.p[perm.p[xa] + yb] + zb];
+        int const h100 = perm.p[perm.p[perm.p[xb] + ya] + za];
+        int const h101 = perm.p[perm.p[perm.p[xb] + ya] + zb];
+        int const h110 = perm.p[perm.p[perm.p[xb] + yb] + za];
+        int const h111 = perm.p[perm.p[perm.p[xb] + yb] + zb];
+
+        T const x11 = lerp(dot_grad(h000, xf0, yf0, zf0), dot_grad(h100, xf1, yf0, zf0), u);
+        T const x12 = lerp(dot_grad(h010, xf0, yf1, zf0), dot_grad(h110, xf1, yf1, zf0), u);
+        T const x21 = lerp(dot_grad(h001, xf0, yf0, zf1), dot_grad(h101, xf1, yf0, zf1), u);
+        T const x22 = lerp(dot_grad(h011, xf0, yf1, zf1), dot_grad(h111, xf1, yf1, zf1), u);
+
+        T const y1 = lerp(x11, x12, v);
+        T const y2 = lerp(x21, x22, v);
+
+        return lerp(y1, y2, w);
+    }
+
+    template<typename T>
+    constexpr auto perlin_periodic(T x, int px) -> T {
+        return perlin_periodic(default_permutation, x, px);
+    }
+
+    template<typename T>
+    constexpr auto perlin_periodic(T x, T y, int px, int py) -> T {
+        return perlin_periodic(default_permutation, x, y, px, py);
+    }
+
+    template<typename T>
+    constexpr auto perlin_periodic(T x, T y, T z, int px, int py, int pz) -> T {
+        return perlin_periodic(default_permutation, x, y, z, px, py, pz);
+    }
+
+    // Simplex noise divides space into simplices (triangles in 2D, tetrahedra in 3D, and so on)
+    // rather than hypercubes, so each sample only depends on the n + 1 corners of the simplex that
+    // contains it instead of all 2^n corners of a unit-cube. Every corner contributes the dot product
+    // of its gradient with the distance vector, attenuated by a radial falloff, and there is no
+    // interpolation between the corners. The gradients are selected by the same permutation tables
+    // as in Perlin noise.
+    //
+    // The implementation follows the one by Stefan Gustavson, except that the falloff has a radius
+    // of sqrt(0.5) in every dimension (rather than sqrt(0.6) in 3D and 4D), which keeps the noise
+    // continuous across the boundaries of the simplices:
+    // - https://github.com/stegu/perlin-noise/blob/master/src/simplexnoise1234.c
+    //
+    // The sums are scaled to the range of [-1, 1]. The scales are slightly below the reciprocals of
+    // the largest possible magnitudes of the sums, which were found by choosing the gradient with the
+    // largest contribution at every corner and maximizing over the positions within a simplex.
+
+    template<typename T>
+    static constexpr auto simplex_grad(int hash, T x) -> T {
+        // In 1D case, the gradient is an integer between 1 and 8 with either sign.
+        int const h = hash & 0xF;
+        T const g = T(1 + (h & 0x7));
+        return (h & 0x8) ? -g * x : g * x;
+    }
+
+    template<typename T>
+    static constexpr auto simplex_grad(int hash, T x, T y) -> T {
+        // In 2D case, the gradient is one of 8 vectors of the same length:
+        //
+        //   (1, 2), (-1, 2), (1, -2), (-1, -2), (2, 1), (-2, 1), (2, -1), (-2, -1)
+        int const h = hash & 0x7;
+        T const u = (h < 0x4) ? x : y;
+        T const v = (h < 0x4) ? y : x;
+        return ((h & 0x1) ? -u : u) + ((h & 0x2) ? T(-2.0) * v : T(2.0) * v);
+    }
+
+    template<typename T>
+    static constexpr auto simplex_grad(int hash, T x, T y, T z, T w) -> T {
+        // In 4D case, the gradient is one of 32 vectors pointing to the middles of the edges of
+        // a unit-tesseract, i.e. one of the components is zero and the rest are either 1 or -1.
+        // The 3D case uses the same gradients as Perlin noise (see `dot_grad`).
+        int const h = hash & 0x1F;
+        T const a = (h < 0x18) ? x : y;
+        T const b = (h < 0x10) ? y : z;
+        T const c = (h < 0x08) ? z : w;
+        return ((h & 0x1) ? -a : a) + ((h & 0x2) ? -b : b) + ((h & 0x4) ? -c : c);
+    }
+
+    // The contribution of a corner fades out to zero at the distance of sqrt(0.5) from it.
+    template<typename T>
+    static constexpr auto simplex_falloff(T distance2) -> T {
+        T const t = T(0.5) - distance2;
+        return (t > T(0.0)) ? (t * t) * (t * t) : T(0.0);
+    }
+
+    template<typename T>
+    static constexpr auto simplex_scalar(permutation const& perm, T x) -> T {
+        // In 1D case, the simplices are unit-lines, and the contributions of both ends fade out
+        // at the distance of 1 instead.
+        int const i0 = floor(x);
+        int const i = i0 & 0xFF;
+
+        T const x0 = x - T(i0);
+        T const x1 = x0 - T(1.0);
+
+        T const t0 = T(1.0) - x0 * x0;
+        T const t1 = T(1.0) - x1 * x1;
+
+        T const n0 = (t0 * t0) * (t0 * t0) * simplex_grad(perm.p[i + 0], x0);
+        T const n1 = (t1 * t1) * (t1 * t1) * simplex_grad(perm.p[i + 1], x1);
+
+        return T(0.395) * (n0 + n1);
+    }
+
+    template<typename T>
+    static constexpr auto simplex_scalar(permutation const& perm, T x, T y) -> T {
+        // Factors that skew the input space onto a grid of unit-squares (each made of two
+        // simplices), and unskew it back: (sqrt(3) - 1) / 2 and (3 - sqrt(3)) / 6.
+        T const F2 = T(0.36602540378443864676);
+        T const G2 = T(0.21132486540518711775);
+
+        // Top-left coordinates of the skewed unit-square.
+        T const s = (x + y) * F2;
+        int const i0 = floor(x + s);
+        int const j0 = floor(y + s);
+
+        // Distance vector from the first corner of the simplex.
+        T const t = T(i0 + j0) * G2;
+        T const x0 = x - (T(i0) - t);
+        T const y0 = y - (T(j0) - t);
+
+        // The input lies either in the lower or in the upper triangle of the unit-square, which
+        // determines the middle corner of the simplex.
+        int const i1 = (x0 > y0) ? 1 : 0;
+        int const j1 = 1 - i1;
+
+        T const x1 = x0 - T(i1) + G2;
+        T const y1 = y0 - T(j1) + G2;
+        T const x2 = x0 - T(1.0) + T(2.0) * G2;
+        T const y2 = y0 - T(1.0) + T(2.0) * G2;
+
+        // Wrap to range 0-255.
+        int const i = i0 & 0xFF;
+        int const j = j0 & 0xFF;
+
+        // Generate hash values for each corner of the simplex.
+        int const h0 = perm.p[perm.p[i + 0] + j + 0];
+        int const h1 = perm.p[perm.p[i + i1] + j + j1];
+        int const h2 = perm.p[perm.p[i + 1] + j + 1];
+
+        T const n0 = simplex_falloff(x0 * x0 + y0 * y0) * simplex_grad(h0, x0, y0);
+        T const n1 = simplex_falloff(x1 * x1 + y1 * y1) * simplex_grad(h1, x1, y1);
+        T const n2 = simplex_falloff(x2 * x2 + y2 * y2) * simplex_grad(h2, x2, y2);
+
+        return T(45.23) * (n0 + n1 + n2);
+    }
+
+    template<typename T>
+    static constexpr auto simplex_scalar(permutation const& perm, T x, T y, T z) -> T {
+        T const F3 = T(1.0) / T(3.0);
+        T const G3 = T(1.0) / T(6.0);
+
+        // Top-left coordinates of the skewed unit-cube.
+        T const s = (x + y + z) * F3;
+        int const i0 = floor(x + s);
+        int const j0 = floor(y + s);
+        int const k0 = floor(z + s);
+
+        // Distance vector from the first corner of the simplex.
+        T const t = T(i0 + j0 + k0) * G3;
+        T const x0 = x - (T(i0) - t);
+        T const y0 = y - (T(j0) - t);
+        T const z0 = z - (T(k0) - t);
+
+        // The unit-cube is made of 6 simplices. The one that contains the input is found by ranking
+        // the components of the distance vector: the path from the first corner to the last one
+        // steps along the axes from the largest component to the smallest.
+        int const rx = (x0 > y0 ? 1 : 0) + (x0 > z0 ? 1 : 0);
+        int const ry = (x0 > y0 ? 0 : 1) + (y0 > z0 ? 1 : 0);
+        int const rz = (x0 > z0 ? 0 : 1) + (y0 > z0 ? 0 : 1);
+
+        int const i1 = (rx >= 2) ? 1 : 0;
+        int const j1 = (ry >= 2) ? 1 : 0;
+        int const k1 = (rz >= 2) ? 1 : 0;
+        int const i2 = (rx >= 1) ? 1 : 0;
+        int const j2 = (ry >= 1) ? 1 : 0;
+        int const k2 = (rz >= 1) ? 1 : 0;
+
+        T const x1 = x0 - T(i1) + G3;
+        T const y1 = y0 - T(j1) + G3;
+        T const z1 = z0 - T(k1) + G3;
+        T const x2 = x0 - T(i2) + T(2.0) * G3;
+        T const y2 = y0 - T(j2) + T(2.0) * G3;
+        T const z2 = z0 - T(k2) + T(2.0) * G3;
+        T const x3 = x0 - T(1.0) + T(3.0) * G3;
+        T const y3 = y0 - T(1.0) + T(3.0) * G3;
+        T const z3 = z0 - T(1.0) + T(3.0) * G3;
+
+        // Wrap to range 0-255.
+        int const i = i0 & 0xFF;
+        int const j = j0 & 0xFF;
+        int const k = k0 & 0xFF;
+
+        // Generate hash values for each corner of the simplex.
+        int const h0 = perm.p[perm.p[perm.p[i + 0] + j + 0] + k + 0];
+        int const h1 = perm.p[perm.p[perm.p[i + i1] + j + j1] + k + k1];
+        int const h2 = perm.p[perm.p[perm.p[i + i2] + j + j2] + k + k2];
+        int const h3 = perm.p[perm.p[perm.p[i + 1] + j + 1] + k + 1];
+
+        T const n0 = simplex_falloff(x0 * x0 + y0 * y0 + z0 * z0) * dot_grad(h0, x0, y0, z0);
+        T const n1 = simplex_falloff(x1 * x1 + y1 * y1 + z1 * z1) * dot_grad(h1, x1, y1, z1);
+        T const n2 = simplex_falloff(x2 * x2 + y2 * y2 + z2 * z2) * dot_grad(h2, x2, y2, z2);
+        T const n3 = simplex_falloff(x3 * x3 + y3 * y3 + z3 * z3) * dot_grad(h3, x3, y3, z3);
+
+        return T(76.88) * (n0 + n1 + n2 + n3);
+    }
+
+    template<typename T>
+    static constexpr auto simplex_scalar(permutation const& perm, T x, T y, T z, T w) -> T {
+        // Skewing factors: (sqrt(5) - 1) / 4 and (5 - sqrt(5)) / 20.
+        T const F4 = T(0.30901699437494742410);
+        T const G4 = T(0.13819660112501051518);
+
+        // Top-left coordinates of the skewed unit-tesseract.
+        T const s = (x + y + z + w) * F4;
+        int const i0 = floor(x + s);
+        int const j0 = floor(y + s);
+        int const k0 = floor(z + s);
+        int const l0 = floor(w + s);
+
+        // Distance vector from the first corner of the simplex.
+        T const t = T(i0 + j0 + k0 + l0) * G4;
+        T const x0 = x - (T(i0) - t);
+        T const y0 = y - (T(j0) - t);
+        T const z0 = z - (T(k0) - t);
+        T const w0 = w - (T(l0) - t);
+
+        // The unit-tesseract is made of 24 simplices, which are told apart in the same way as in 3D.
+        int const rx = (x0 > y0 ? 1 : 0) + (x0 > z0 ? 1 : 0) + (x0 > w0 ? 1 : 0);
+        int const ry = (x0 > y0 ? 0 : 1) + (y0 > z0 ? 1 : 0) + (y0 > w0 ? 1 : 0);
+        int const rz = (x0 > z0 ? 0 : 1) + (y0 > z0 ? 0 : 1) + (z0 > w0 ? 1 : 0);
+        int const rw = (x0 > w0 ? 0 : 1) + (y0 > w0 ? 0 : 1) + (z0 > w0 ? 0 : 1);
+
+        int const i1 = (rx >= 3) ? 1 : 0;
+        int const j1 = (ry >= 3) ? 1 : 0;
+        int const k1 = (rz >= 3) ? 1 : 0;
+        int const l1 = (rw >= 3) ? 1 : 0;
+        int const i2 = (rx >= 2) ? 1 : 0;
+        int const j2 = (ry >= 2) ? 1 : 0;
+        int const k2 = (rz >= 2) ? 1 : 0;
+        int const l2 = (rw >= 2) ? 1 : 0;
+        int const i3 = (rx >= 1) ? 1 : 0;
+        int const j3 = (ry >= 1) ? 1 : 0;
+        int const k3 = (rz >= 1) ? 1 : 0;
+        int const l3 = (rw >= 1) ? 1 : 0;
+
+        T const x1 = x0 - T(i1) + G4;
+        T const y1 = y0 - T(j1) + G4;
+        T const z1 = z0 - T(k1) + G4;
+        T const w1 = w0 - T(l1) + G4;
+        T const x2 = x0 - T(i2) + T(2.0) * G4;
+        T const y2 = y0 - T(j2) + T(2.0) * G4;
+        T const z2 = z0 - T(k2) + T(2.0) * G4;
+        T const w2 = w0 - T(l2) + T(2.0) * G4;
+        T const x3 = x0 - T(i3) + T(3.0) * G4;
+        T const y3 = y0 - T(j3) + T(3.0) * G4;
+        T const z3 = z0 - T(k3) + T(3.0) * G4;
+        T const w3 = w0 - T(l3) + T(3.0) * G4;
+        T const x4 = x0 - T(1.0) + T(4.0) * G4;
+        T const y4 = y0 - T(1.0) + T(4.0) * G4;
+        T const z4 = z0 - T(1.0) + T(4.0) * G4;
+        T const w4 = w0 - T(1.0) + T(4.0) * G4;
+
+        // Wrap to range 0-255.
+        int const i = i0 & 0xFF;
+        int const j = j0 & 0xFF;
+        int const k = k0 & 0xFF;
+        int const l = l0 & 0xFF;
+
+        // Generate hash values for each corner of the simplex.
+        int const h0 = perm.p[perm.p[perm.p[perm.p[i + 0] + j + 0] + k + 0] + l + 0];
+        int const h1 = perm.p[perm.p[perm.p[perm.p[i + i1] + j + j1] + k + k1] + l + l1];
+        int const h2 = perm.p[perm.p[perm.p[perm.p[i + i2] + j + j2] + k + k2] + l + l2];
+        int const h3 = perm.p[perm.p[perm.p[perm.p[i + i3] + j + j3] + k + k3] + l + l3];
+        int const h4 = perm.p[perm.p[perm.p[perm.p[i + 1] + j + 1] + k + 1] + l + 1];
+
+        T const n0 = simplex_falloff(x0 * x0 + y0 * y0 + z0 * z0 + w0 * w0) * simplex_grad(h0, x0, y0, z0, w0);
+        T const n1 = simplex_falloff(x1 * x1 + y1 * y1 + z1 * z1 + w1 * w1) * simplex_grad(h1, x1, y1, z1, w1);
+        T const n2 = simplex_falloff(x2 * x2 + y2 * y2 + z2 * z2 + w2 * w2) * simplex_grad(h2, x2, y2, z2, w2);
+        T const n3 = simplex_falloff(x3 * x3 + y3 * y3 + z3 * z3 + w3 * w3) * simplex_grad(h3, x3, y3, z3, w3);
+        T const n4 = simplex_falloff(x4 * x4 + y4 * y4 + z4 * z4 + w4 * w4) * simplex_grad(h4, x4, y4, z4, w4);
+
+        return T(62.77) * (n0 + n1 + n2 + n3 + n4);
+    }
+
+    template<typename T>
+    static constexpr auto simplex(permutation const& perm, T x) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 1);
+        return simplex_scalar(perm, x);
+    }
+
+    template<typename T>
+    static constexpr auto simplex(permutation const& perm, T x, T y) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 2);
+        return simplex_scalar(perm, x, y);
+    }
+
+    template<typename T>
+    static constexpr auto simplex(permutation const& perm, T x, T y, T z) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 3);
+        return simplex_scalar(perm, x, y, z);
+    }
+
+    template<typename T>
+    static constexpr auto simplex(permutation const& perm, T x, T y, T z, T w) -> T {
+        DB_PERLIN_PROFILE_SCALAR(T, 4);
+        return simplex_scalar(perm, x, y, z, w);
+    }
+
+    template<typename T>
+    constexpr auto simplex(T x) -> T {
+        return simplex(default_permutation, x);
+    }
+
+    template<typename T>
+    constexpr auto simplex(T x, T y) -> T {
+        return simplex(default_permutation, x, y);
+    }
+
+    template<typename T>
+    constexpr auto simplex(T x, T y, T z) -> T {
+        return simplex(default_permutation, x, y, z);
+    }
+
+    template<typename T>
+    constexpr auto simplex(T x, T y, T z, T w) -> T {
+        return simplex(default_permutation, x, y, z, w);
+    }
+
+    // The derivatives follow from differentiating the interpolation of the corner dot products:
+    // each corner contributes its gradient vector (weighted by the fade values along the other
+    // axes), while the fade curve along an axis contributes its derivative times the difference
+    // between the values being interpolated along that axis.
+
+    // Gradient vectors of the 2D and 3D noise, in the same order as they are selected by `dot_grad`.
+    static constexpr signed char grad2[8][2] = {
+        {  1,  1 }, {  1,  0 }, {  1, -1 }, {  0, -1 }, { -1, -1 }, { -1,  0 }, { -1,  1 }, {  0,  1 },
+    };
+
+    static constexpr signed char grad3[16][3] = {
+        {  1,  1,  0 }, { -1,  1,  0 }, {  1, -1,  0 }, { -1, -1,  0 },
+        {  1,  0,  1 }, { -1,  0,  1 }, {  1,  0, -1 }, { -1,  0, -1 },
+        {  0,  1,  1 }, {  0, -1,  1 }, {  0,  1, -1 }, {  0, -1, -1 },
+        {  1,  1,  0 }, {  0, -1,  1 }, { -1,  1,  0 }, {  0, -1, -1 },
+    };
+
+    // Interpolates one component of the gradient vectors of two corners of a unit-cube.
+    template<typename T>
+    static constexpr auto lerp_grad(int ha, int hb, int axis, T t) -> T {
+        return lerp(T(grad3[ha & 0xF][axis]), T(grad3[hb & 0xF][axis]), t);
+    }
+
+    template<typename T>
+    static constexpr auto perlin_d(permutation const& perm, T x) -> noise_gradient<T> {
+        DB_PERLIN_PROFILE_SCALAR(T, 1);
+
+        int const xi0 = floor(x);
+
+        T const xf0 = x - T(xi0);
+        T const xf1 = xf0 - T(1.0);
+
+        int const xi = xi0 & 0xFF;
+
+        T const u = fade(xf0);
+        T const du = fade_derivative(xf0);
+
+        int const h0 = perm.p[xi + 0];
+        int const h1 = perm.p[xi + 1];
+
+        T const d0 = dot_grad(h0, xf0);
+        T const d1 = dot_grad(h1, xf1);
+        T const g0 = dot_grad(h0, T(1.0));
+        T const g1 = dot_grad(h1, T(1.0));
+
+        return noise_gradient<T> { lerp(d0, d1, u), lerp(g0, g1, u) + du * (d1 - d0), T(0.0), T(0.0) };
+    }
+
+    template<typename T>
+    static constexpr auto perlin_d(permutation const& perm, T x, T y) -> noise_gradient<T> {
+        DB_PERLIN_PROFILE_SCALAR(T, 2);
+
+        int const xi0 = floor(x);
+        int const yi0 = floor(y);
+
+        T const xf0 = x - T(xi0);
+        T const yf0 = y - T(yi0);
+        T const xf1 = xf0 - T(1.0);
+        T const yf1 = yf0 - T(1.0);
+
+        int const xi = xi0 & 0xFF;
+        int const yi = yi0 & 0xFF;
+
+        T const u = fade(xf0);
+        T const v = fade(yf0);
+        T const du = fade_derivative(xf0);
+        T const dv = fade_derivative(yf0);
+
+        int const h00 = perm.p[perm.p[xi + 0] + yi + 0];
+        int const h01 = perm.p[perm.p[xi + 0] + yi + 1];
+        int const h10 = perm.p[perm.p[xi + 1] + yi + 0];
+        int const h11 = perm.p[perm.p[xi + 1] + yi + 1];
+
+        // Dot products of each gradient with its distance to the input location.
+        T const d00 = dot_grad(h00, xf0, yf0);
+        T const d10 = dot_grad(h10, xf1, yf0);
+        T const d01 = dot_grad(h01, xf0, yf1);
+        T const d11 = dot_grad(h11, xf1, yf1);
+
+        // The gradient vectors themselves.
+        T const g00x = T(grad2[h00 & 0x7][0]), g00y = T(grad2[h00 & 0x7][1]);
+        T const g10x = T(grad2[h10 & 0x7][0]), g10y = T(grad2[h10 & 0x7][1]);
+        T const g01x = T(grad2[h01 & 0x7][0]), g01y = T(grad2[h01 & 0x7][1]);
+        T const g11x = T(grad2[h11 & 0x7][0]), g11y = T(grad2[h11 & 0x7][1]);
+
+        T const x1 = lerp(d00, d10, u);
+        T const x2 = lerp(d01, d11, u);
+
+        T const x1dx = lerp(g00x, g10x, u) + du * (d10 - d00);
+        T const x2dx = lerp(g01x, g11x, u) + du * (d11 - d01);
+        T const x1dy = lerp(g00y, g10y, u);
+        T const x2dy = lerp(g01y, g11y, u);
+
+        return noise_gradient<T> {
+            lerp(x1, x2, v),
+            lerp(x1dx, x2dx, v),
+            lerp(x1dy, x2dy, v) + dv * (x2 - x1),
+            T(0.0),
+        };
+    }
+
+    template<typename T>
+    static constexpr auto perlin_d(permutation const& perm, T x, T y, T z) -> noise_gradient<T> {
+        DB_PERLIN_PROFILE_SCALAR(T, 3);
+
+        int const xi0 = floor(x);
+        int const yi0 = floor(y);
+        int const zi0 = floor(z);
+
+        T const xf0 = x - T(xi0);
+        T const yf0 = y - T(yi0);
+        T const zf0 = z - T(zi0);
+        T const xf1 = xf0 - T(1.0);
+        T const yf1 = yf0 - T(1.0);
+        T const zf1 = zf0 - T(1.0);
+
+        int const xi = xi0 & 0xFF;
+        int const yi = yi0 & 0xFF;
+        int const zi = zi0 & 0xFF;
+
+        T const u = fade(xf0);
+        T const v = fade(yf0);
+        T const w = fade(zf0);
+        T const du = fade_derivative(xf0);
+        T const dv = fade_derivative(yf0);
+        T const dw = fade_derivative(zf0);
+
+        int const h000 = perm.p[perm.p[perm.p[xi + 0] + yi + 0] + zi + 0];
+        int const h001 = perm.p[perm.p[perm.p[xi + 0] + yi + 0] + zi + 1];
+        int const h010 = perm.p[perm.p[perm.p[xi + 0] + yi + 1] + zi + 0];
+        int const h011 = perm.p[perm.p[perm.p[xi + 0] + yi + 1] + zi + 1];
+        int const h100 = perm.p[perm.p[perm.p[xi + 1] + yi + 0] + zi + 0];
+        int const h101 = perm.p[perm.p[perm.p[xi + 1] + yi + 0] + zi + 1];
+        int const h110 = perm.p[perm.p[perm.p[xi + 1] + yi + 1] + zi + 0];
+        int const h111 = perm.p[perm.p[perm.p[xi + 1] + yi + 1] + zi + 1];
+
+        // Dot products of each gradient with its distance to the input location.
+        T const d000 = dot_grad(h000, xf0, yf0, zf0);
+        T const d100 = dot_grad(h100, xf1, yf0, zf0);
+        T const d010 = dot_grad(h010, xf0, yf1, zf0);
+        T const d110 = dot_grad(h110, xf1, yf1, zf0);
+        T const d001 = dot_grad(h001, xf0, yf0, zf1);
+        T const d101 = dot_grad(h101, xf1, yf0, zf1);
+        T const d011 = dot_grad(h011, xf0, yf1, zf1);
+        T const d111 = dot_grad(h111, xf1, yf1, zf1);
+
+        T const x11 = lerp(d000, d100, u);
+        T const x12 = lerp(d010, d110, u);
+        T const x21 = lerp(d001, d101, u);
+        T const x22 = lerp(d011, d111, u);
+
+        T const x11dx = lerp_grad(h000, h100, 0, u) + du * (d100 - d000);
+        T const x12dx = lerp_grad(h010, h110, 0, u) + du * (d110 - d010);
+        T const x21dx = lerp_grad(h001, h101, 0, u) + du * (d101 - d001);
+        T const x22dx = lerp_grad(h011, h111, 0, u) + du * (d111 - d011);
+
+        T const x11dy = lerp_grad(h000, h100, 1, u);
+        T const x12dy = lerp_grad(h010, h110, 1, u);
+        T const x21dy = lerp_grad(h001, h101, 1, u);
+        T const x22dy = lerp_grad(h011, h111, 1, u);
+
+        T const x11dz = lerp_grad(h000, h100, 2, u);
+        T const x12dz = lerp_grad(h010, h110, 2, u);
+        T const x21dz = lerp_grad(h001, h101, 2, u);
+        T const x22dz = lerp_grad(h011, h111, 2, u);
+
+        T const y1 = lerp(x11, x12, v);
+        T const y2 = lerp(x21, x22, v);
+
+        T const y1dx = lerp(x11dx, x12dx, v);
+        T const y2dx = lerp(x21dx, x22dx, v);
+        T const y1dy = lerp(x11dy, x12dy, v) + dv * (x12 - x11);
+        T const y2dy = lerp(x21dy, x22dy, v) + dv * (x22 - x21);
+        T const y1dz = lerp(x11dz, x12dz, v);
+        T const y2dz = lerp(x21dz, x22dz, v);
+
+        return noise_gradient<T> {
+            lerp(y1, y2, w),
+            lerp(y1dx, y2dx, w),
+            lerp(y1dy, y2dy, w),
+            lerp(y1dz, y2dz, w) + dw * (y2 - y1),
+        };
+    }
+
+    template<typename T>
+    constexpr auto perlin_d(T x) -> noise_gradient<T> {
+        return perlin_d(default_permutation, x);
+    }
+
+    template<typename T>
+    constexpr auto perlin_d(T x, T y) -> noise_gradient<T> {
+        return perlin_d(default_permutation, x, y);
+    }
+
+    template<typename T>
+    constexpr auto perlin_d(T x, T y, T z) -> noise_gradient<T> {
+        return perlin_d(default_permutation, x, y, z);
+    }
+
+    // Number of grid columns processed at a time by the fill functions. Per-column values are
+    // kept in small arrays of this size on the stack, so no allocations are necessary.
+    static constexpr int fill_block = 64;
+
+    // Fills a grid with the noise multiplied by `amplitude`, optionally adding it to the values
+    // already present in the buffer. Rows of the grid are `stride` elements apart.
+    template<typename T>
+    static auto fill_2d(permutation const& perm, T* out, long long stride, int width, int height, T x0, T y0, T step, T amplitude, bool accumulate) -> void {
+        int xi[fill_block];
+        T xf0[fill_block];
+        T u[fill_block];
+
+        for (int bx = 0; bx < width; bx += fill_block) {
+            int const n = (width - bx < fill_block) ? width - bx : fill_block;
+
+            // Everything that depends on the column alone is computed once per block.
+            for (int i = 0; i < n; ++i) {
+                T const x = x0 + T(bx + i) * step;
+                int const xi0 = floor(x);
+                xf0[i] = x - T(xi0);
+                xi[i] = xi0 & 0xFF;
+                u[i] = fade(xf0[i]);
+            }
+
+            for (int j = 0; j < height; ++j) {
+                T const y = y0 + T(j) * step;
+                int const yi0 = floor(y);
+                T const yf0 = y - T(yi0);
+                T const yf1 = yf0 - T(1.0);
+                int const yi = yi0 & 0xFF;
+                T const v = fade(yf0);
+
+                T* const row = out + j * stride + bx;
+
+                // Samples that fall into the same unit-square share their hashes, so they
+                // are only looked up when the walk crosses into the next square.
+                int cell = -1;
+                int h00 = 0, h01 = 0, h10 = 0, h11 = 0;
+
+                for (int i = 0; i < n; ++i) {
+                    if (xi[i] != cell) {
+                        cell = xi[i];
+                        int const a = perm.p[cell + 0] + yi;
+                        int const b = perm.p[cell + 1] + yi;
+                        h00 = perm.p[a + 0];
+                        h01 = perm.p[a + 1];
+                        h10 = perm.p[b + 0];
+                        h11 = perm.p[b + 1];
+                    }
+
+                    T const xf1 = xf0[i] - T(1.0);
+                    T const x1 = lerp(dot_grad(h00, xf0[i], yf0), dot_grad(h10, xf1, yf0), u[i]);
+                    T const x2 = lerp(dot_grad(h01, xf0[i], yf1), dot_grad(h11, xf1, yf1), u[i]);
+                    T const value = amplitude * lerp(x1, x2, v);
+                    row[i] = accumulate ? row[i] + value : value;
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    static auto fill_3d(permutation const& perm, T* out, int width, int height, int depth, T x0, T y0, T z0, T step, T amplitude, bool accumulate) -> void {
+        int xi[fill_block];
+        T xf0[fill_block];
+        T u[fill_block];
+
+        for (int bx = 0; bx < width; bx += fill_block) {
+            int const n = (width - bx < fill_block) ? width - bx : fill_block;
+
+            // Everything that depends on the column alone is computed once per block.
+            for (int i = 0; i < n; ++i) {
+                T const x = x0 + T(bx + i) * step;
+                int const xi0 = floor(x);
+                xf0[i] = x - T(xi0);
+                xi[i] = xi0 & 0xFF;
+                u[i] = fade(xf0[i]);
+            }
+
+            for (int k = 0; k < depth; ++k) {
+                T const z = z0 + T(k) * step;
+                int const zi0 = floor(z);
+                T const zf0 = z - T(zi0);
+                T const zf1 = zf0 - T(1.0);
+                int const zi = zi0 & 0xFF;
+                T const w = fade(zf0);
+
+                for (int j = 0; j < height; ++j) {
+                    T const y = y0 + T(j) * step;
+                    int const yi0 = floor(y);
+                    T const yf0 = y - T(yi0);
+                    T const yf1 = yf0 - T(1.0);
+                    int const yi = yi0 & 0xFF;
+                    T const v = fade(yf0);
+
+                    T* const row = out + (static_cast<long long>(k) * height + j) * width + bx;
+
+                    // Samples that fall into the same unit-cube share their hashes, so they
+                    // are only looked up when the walk crosses into the next cube.
+                    int cell = -1;
+                    int h000 = 0, h001 = 0, h010 = 0, h011 = 0;
+                    int h100 = 0, h101 = 0, h110 = 0, h111 = 0;
+
+                    for (int i = 0; i < n; ++i) {
+                        if (xi[i] != cell) {
+                            cell = xi[i];
+                            int const a = perm.p[cell + 0] + yi;
+                            int const b = perm.p[cell + 1] + yi;
+                            int const aa = perm.p[a + 0] + zi;
+                            int const ab = perm.p[a + 1] + zi;
+                            int const ba = perm.p[b + 0] + zi;
+                            int const bb = perm.p[b + 1] + zi;
+                            h000 = perm.p[aa + 0];
+                            h001 = perm.p[aa + 1];
+                            h010 = perm.p[ab + 0];
+                            h011 = perm.p[ab + 1];
+                            h100 = perm.p[ba + 0];
+                            h101 = perm.p[ba + 1];
+                            h110 = perm.p[bb + 0];
+                            h111 = perm.p[bb + 1];
+                        }
+
+                        T const xf1 = xf0[i] - T(1.0);
+                        T const x11 = lerp(dot_grad(h000, xf0[i], yf0, zf0), dot_grad(h100, xf1, yf0, zf0), u[i]);
+                        T const x12 = lerp(dot_grad(h010, xf0[i], yf1, zf0), dot_grad(h110, xf1, yf1, zf0), u[i]);
+                        T const x21 = lerp(dot_grad(h001, xf0[i], yf0, zf1), dot_grad(h101, xf1, yf0, zf1), u[i]);
+                        T const x22 = lerp(dot_grad(h011, xf0[i], yf1, zf1), dot_grad(h111, xf1, yf1, zf1), u[i]);
+
+                        T const y1 = lerp(x11, x12, v);
+                        T const y2 = lerp(x21, x22, v);
+
+                        T const value = amplitude * lerp(y1, y2, w);
+                        row[i] = accumulate ? row[i] + value : value;
+                    }
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    auto perlin_fill_2d(T* out, int width, int height, T x0, T y0, T step) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_fill_2d", 2, static_cast<long long>(width) * height);
+        fill_2d(default_permutation, out, width, width, height, x0, y0, step, T(1.0), false);
+    }
+
+    template<typename T>
+    auto perlin_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_fill_3d", 3, static_cast<long long>(width) * height * depth);
+        fill_3d(default_permutation, out, width, height, depth, x0, y0, z0, step, T(1.0), false);
+    }
+
+    // The fixed-point fills keep the coordinates with 32 fractional bits, so that stepping through
+    // the grid is exact, and round every sample to 16 fractional bits (Q16) to evaluate the noise.
+    // Only the low 8 bits of the integer part of a coordinate are ever used, so the origins and
+    // the step are reduced modulo 256 before conversion, and the grid is stepped through with
+    // unsigned arithmetic, which may wrap around without affecting those bits. This keeps every
+    // finite coordinate in range, however large.
+    // The dot products reuse `dot_grad`, which only ever adds and negates its arguments.
+    static constexpr std::int32_t fixed_one = 1 << 16;
+
+    static auto to_fixed(double x) -> std::uint64_t {
+        double const wrapped = std::fmod(x, 256.0);
+        return std::uint64_t(((wrapped < 0.0) ? wrapped + 256.0 : wrapped) * 4294967296.0 + 0.5);
+    }
+
+    static constexpr auto fade_fixed(std::int32_t t) -> std::int32_t {
+        // Both factors are kept with 24 fractional bits, as the cube is tiny near zero and the
+        // polynomial reaches up to 10; the final product is rounded back to Q16.
+        std::int64_t const t1 = t;
+        std::int64_t const t3 = (t1 * t1 * t1) >> 24;
+        std::int64_t const poly = ((t1 * (t1 * 6 - 15 * std::int64_t(fixed_one))) >> 8) + (std::int64_t(10) << 24);
+        return std::int32_t((t3 * poly + (std::int64_t(1) << 31)) >> 32);
+    }
+
+    static constexpr auto lerp_fixed(std::int32_t a, std::int32_t b, std::int32_t t) -> std::int32_t {
+        return a + std::int32_t((std::int64_t(t) * (b - a) + (fixed_one >> 1)) >> 16);
+    }
+
+    // Maps a Q16 value from [-1, 1] onto [0, max] with rounding, saturating outside of the range.
+    template<typename Out>
+    static constexpr auto quantize_fixed(std::int32_t value) -> Out {
+        std::int64_t const max = Out(~Out(0));
+        std::int64_t const q = ((std::int64_t(value) + fixed_one) * max + fixed_one) >> 17;
+        return Out((q < 0) ? 0 : (q > max) ? max : q);
+    }
+
+    template<typename Out>
+    static auto fill_2d_fixed(permutation const& perm, Out* out, int width, int height, double x0, double y0, double step) -> void {
+        DB_PERLIN_PROFILE_BATCH(double, "perlin_fill_2d_fixed", 2, static_cast<long long>(width) * height);
+
+        std::uint64_t const fx0 = to_fixed(x0);
+        std::uint64_t const fy0 = to_fixed(y0);
+        std::uint64_t const fstep = to_fixed(step);
+
+        int xi[fill_block];
+        std::int32_t xf0[fill_block];
+        std::int32_t u[fill_block];
+
+        for (int bx = 0; bx < width; bx += fill_block) {
+            int const n = (width - bx < fill_block) ? width - bx : fill_block;
+
+            for (int i = 0; i < n; ++i) {
+                std::uint64_t const x = (fx0 + std::uint64_t(bx + i) * fstep + (fixed_one >> 1)) >> 16;
+                xi[i] = int(x >> 16) & 0xFF;
+                xf0[i] = std::int32_t(x & 0xFFFF);
+                u[i] = fade_fixed(xf0[i]);
+            }
+
+            for (int j = 0; j < height; ++j) {
+                std::uint64_t const y = (fy0 + std::uint64_t(j) * fstep + (fixed_one >> 1)) >> 16;
+                int const yi = int(y >> 16) & 0xFF;
+                std::int32_t const yf0 = std::int32_t(y & 0xFFFF);
+                std::int32_t const yf1 = yf0 - fixed_one;
+                std::int32_t const v = fade_fixed(yf0);
+
+                Out* const row = out + static_cast<long long>(j) * width + bx;
+
+                int cell = -1;
+                int h00 = 0, h01 = 0, h10 = 0, h11 = 0;
+
+                for (int i = 0; i < n; ++i) {
+                    if (xi[i] != cell) {
+                        cell = xi[i];
+                        int const a = perm.p[cell + 0] + yi;
+                        int const b = perm.p[cell + 1] + yi;
+                        h00 = perm.p[a + 0];
+                        h01 = perm.p[a + 1];
+                        h10 = perm.p[b + 0];
+                        h11 = perm.p[b + 1];
+                    }
+
+                    std::int32_t const xf1 = xf0[i] - fixed_one;
+                    std::int32_t const x1 = lerp_fixed(dot_grad(h00, xf0[i], yf0), dot_grad(h10, xf1, yf0), u[i]);
+                    std::int32_t const x2 = lerp_fixed(dot_grad(h01, xf0[i], yf1), dot_grad(h11, xf1, yf1), u[i]);
+                    row[i] = quantize_fixed<Out>(lerp_fixed(x1, x2, v));
+                }
+            }
+        }
+    }
+
+    template<typename Out>
+    static auto fill_3d_fixed(permutation const& perm, Out* out, int width, int height, int depth, double x0, double y0, double z0, double step) -> void {
+        DB_PERLIN_PROFILE_BATCH(double, "perlin_fill_3d_fixed", 3, static_cast<long long>(width) * height * depth);
+
+        std::uint64_t const fx0 = to_fixed(x0);
+        std::uint64_t const fy0 = to_fixed(y0);
+        std::uint64_t const fz0 = to_fixed(z0);
+        std::uint64_t const fstep = to_fixed(step);
+
+        int xi[fill_block];
+        std::int32_t xf0[fill_block];
+        std::int32_t u[fill_block];
+
+        for (int bx = 0; bx < width; bx += fill_block) {
+            int const n = (width - bx < fill_block) ? width - bx : fill_block;
+
+            for (int i = 0; i < n; ++i) {
+                std::uint64_t const x = (fx0 + std::uint64_t(bx + i) * fstep + (fixed_one >> 1)) >> 16;
+                xi[i] = int(x >> 16) & 0xFF;
+                xf0[i] = std::int32_t(x & 0xFFFF);
+                u[i] = fade_fixed(xf0[i]);
+            }
+
+            for (int k = 0; k < depth; ++k) {
+                std::uint64_t const z = (fz0 + std::uint64_t(k) * fstep + (fixed_one >> 1)) >> 16;
+                int const zi = int(z >> 16) & 0xFF;
+                std::int32_t const zf0 = std::int32_t(z & 0xFFFF);
+                std::int32_t const zf1 = zf0 - fixed_one;
+                std::int32_t const w = fade_fixed(zf0);
+
+                for (int j = 0; j < height; ++j) {
+                    std::uint64_t const y = (fy0 + std::uint64_t(j) * fstep + (fixed_one >> 1)) >> 16;
+                    int const yi = int(y >> 16) & 0xFF;
+                    std::int32_t const yf0 = std::int32_t(y & 0xFFFF);
+                    std::int32_t const yf1 = yf0 - fixed_one;
+                    std::int32_t const v = fade_fixed(yf0);
+
+                    Out* const row = out + (static_cast<long long>(k) * height + j) * width + bx;
+
+                    int cell = -1;
+                    int h000 = 0, h001 = 0, h010 = 0, h011 = 0;
+                    int h100 = 0, h101 = 0, h110 = 0, h111 = 0;
+
+                    for (int i = 0; i < n; ++i) {
+                        if (xi[i] != cell) {
+                            cell = xi[i];
+                            int const a = perm.p[cell + 0] + yi;
+                            int const b = perm.p[cell + 1] + yi;
+                            int const aa = perm.p[a + 0] + zi;
+                            int const ab = perm.p[a + 1] + zi;
+                            int const ba = perm.p[b + 0] + zi;
+                            int const bb = perm.p[b + 1] + zi;
+                            h000 = perm.p[aa + 0];
+                            h001 = perm.p[aa + 1];
+                            h010 = perm.p[ab + 0];
+                            h011 = perm.p[ab + 1];
+                            h100 = perm.p[ba + 0];
+                            h101 = perm.p[ba + 1];
+                            h110 = perm.p[bb + 0];
+                            h111 = perm.p[bb + 1];
+                        }
+
+                        std::int32_t const xf1 = xf0[i] - fixed_one;
+                        std::int32_t const x11 = lerp_fixed(dot_grad(h000, xf0[i], yf0, zf0), dot_grad(h100, xf1, yf0, zf0), u[i]);
+                        std::int32_t const x12 = lerp_fixed(dot_grad(h010, xf0[i], yf1, zf0), dot_grad(h110, xf1, yf1, zf0), u[i]);
+                        std::int32_t const x21 = lerp_fixed(dot_grad(h001, xf0[i], yf0, zf1), dot_grad(h101, xf1, yf0, zf1), u[i]);
+                        std::int32_t const x22 = lerp_fixed(dot_grad(h011, xf0[i], yf1, zf1), dot_grad(h111, xf1, yf1, zf1), u[i]);
+
+                        std::int32_t const y1 = lerp_fixed(x11, x12, v);
+                        std::int32_t const y2 = lerp_fixed(x21, x22, v);
+                        row[i] = quantize_fixed<Out>(lerp_fixed(y1, y2, w));
+                    }
+                }
+            }
+        }
+    }
+
+    DB_PERLIN_INLINE auto perlin_fill_2d_u8(std::uint8_t* out, int width, int height, double x0, double y0, double step) -> void {
+        fill_2d_fixed(default_permutation, out, width, height, x0, y0, step);
+    }
+
+    DB_PERLIN_INLINE auto perlin_fill_2d_u16(std::uint16_t* out, int width, int height, double x0, double y0, double step) -> void {
+        fill_2d_fixed(default_permutation, out, width, height, x0, y0, step);
+    }
+
+    DB_PERLIN_INLINE auto perlin_fill_3d_u8(std::uint8_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) -> void {
+        fill_3d_fixed(default_permutation, out, width, height, depth, x0, y0, z0, step);
+    }
+
+    DB_PERLIN_INLINE auto perlin_fill_3d_u16(std::uint16_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) -> void {
+        fill_3d_fixed(default_permutation, out, width, height, depth, x0, y0, z0, step);
+    }
+
+    template<typename T>
+    static constexpr auto abs(T x) -> T {
+        return (x < T(0.0)) ? -x : x;
+    }
+
+    template<typename T>
+    static constexpr auto ridge(T noise) -> T {
+        // Folding the noise around zero and inverting it turns the zero-crossings into sharp crests.
+        T const r = T(1.0) - abs(noise);
+        return r * r;
+    }
+
+    template<typename T>
+    static constexpr auto fbm(permutation const& perm, T x, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * perlin(perm, x * f.frequency[i]);
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto fbm(permutation const& perm, T x, T y, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * perlin(perm, x * f.frequency[i], y * f.frequency[i]);
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto fbm(permutation const& perm, T x, T y, T z, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * perlin(perm, x * f.frequency[i], y * f.frequency[i], z * f.frequency[i]);
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto ridged(permutation const& perm, T x, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * ridge(perlin(perm, x * f.frequency[i]));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto ridged(permutation const& perm, T x, T y, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * ridge(perlin(perm, x * f.frequency[i], y * f.frequency[i]));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto ridged(permutation const& perm, T x, T y, T z, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * ridge(perlin(perm, x * f.frequency[i], y * f.frequency[i], z * f.frequency[i]));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto turbulence(permutation const& perm, T x, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * abs(perlin(perm, x * f.frequency[i]));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto turbulence(permutation const& perm, T x, T y, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * abs(perlin(perm, x * f.frequency[i], y * f.frequency[i]));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto turbulence(permutation const& perm, T x, T y, T z, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * abs(perlin(perm, x * f.frequency[i], y * f.frequency[i], z * f.frequency[i]));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto octave_period(int period, T frequency) -> int {
+        return int(T(period) * frequency + T(0.5));
+    }
+
+    template<typename T>
+    static constexpr auto fbm_periodic(permutation const& perm, T x, int px, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            T const fr = f.frequency[i];
+            sum += f.amplitude[i] * perlin_periodic(perm, x * fr, octave_period(px, fr));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto fbm_periodic(permutation const& perm, T x, T y, int px, int py, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            T const fr = f.frequency[i];
+            sum += f.amplitude[i] * perlin_periodic(perm, x * fr, y * fr, octave_period(px, fr), octave_period(py, fr));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    template<typename T>
+    static constexpr auto fbm_periodic(permutation const& perm, T x, T y, T z, int px, int py, int pz, fractal<T> const& f) -> T {
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            T const fr = f.frequency[i];
+            sum += f.amplitude[i] * perlin_periodic(perm, x * fr, y * fr, z * fr, octave_period(px, fr), octave_period(py, fr), octave_period(pz, fr));
+        }
+        return sum / f.total_amplitude;
+    }
+
+    // Upper bounds of the magnitude of the noise in 1D, 2D, and 3D. At any point of the unit-cube,
+    // each corner contributes at most the largest dot product over all of its possible gradients,
+    // so the bounds are the maxima of these sums (the one in 3D is reached near (0.355, 0.481, 0.5)).
+    static constexpr double perlin_bound[3] = { 0.5, 1.0, 1.0364 };
+
+    // Single octaves of the noise, which let the progressive sums below be shared between dimensions.
+    template<typename T>
+    struct perlin_octave_1d {
+        permutation const& perm;
+        T x;
+
+        constexpr auto operator()(T frequency) const -> T {
+            return perlin(perm, x * frequency);
+        }
+    };
+
+    template<typename T>
+    struct perlin_octave_2d {
+        permutation const& perm;
+        T x, y;
+
+        constexpr auto operator()(T frequency) const -> T {
+            return perlin(perm, x * frequency, y * frequency);
+        }
+    };
+
+    template<typename T>
+    struct perlin_octave_3d {
+        permutation const& perm;
+        T x, y, z;
+
+        constexpr auto operator()(T frequency) const -> T {
+            return perlin(perm, x * frequency, y * frequency, z * frequency);
+        }
+    };
+
+    // Sums up the octaves in the same order as `fbm`, until the ones that remain cannot move the
+    // sum by more than the tolerance.
+    template<typename T, typename Octave>
+    static constexpr auto progressive_sum(Octave const& octave, T bound, fractal<T> const& f, T tolerance) -> T {
+        T remaining = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            remaining += bound * abs(f.amplitude[i]);
+        }
+
+        T const limit = tolerance * f.total_amplitude;
+
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            sum += f.amplitude[i] * octave(f.frequency[i]);
+            remaining -= bound * abs(f.amplitude[i]);
+            if (remaining <= limit) {
+                break;
+            }
+        }
+        return sum / f.total_amplitude;
+    }
+
+    // Sums up the octaves in the same order as `fbm`, until none of the thresholds lie within the
+    // range of values that the remaining octaves may still reach. The range is widened by a margin
+    // that covers the rounding errors of the sum, so that every early decision matches the one
+    // made after summing up all of the octaves.
+    template<typename T, typename Octave>
+    static constexpr auto progressive_classify(Octave const& octave, T bound, fractal<T> const& f, T const* thresholds, int count) -> int {
+        T remaining = T(0.0);
+        for (int i = 0; i < f.octaves; ++i) {
+            remaining += bound * abs(f.amplitude[i]);
+        }
+
+        T const margin = T(4 * (f.octaves + 1)) * std::numeric_limits<T>::epsilon() * (remaining / f.total_amplitude + T(1.0));
+
+        T sum = T(0.0);
+        for (int i = 0; i < f.octaves - 1; ++i) {
+            sum += f.amplitude[i] * octave(f.frequency[i]);
+            remaining -= bound * abs(f.amplitude[i]);
+
+            T const low = (sum - remaining) / f.total_amplitude - margin;
+            T const high = (sum + remaining) / f.total_amplitude + margin;
+
+            int band = 0;
+            bool decided = true;
+            for (int k = 0; k < count; ++k) {
+                if (thresholds[k] < low) {
+                    ++band;
+                } else if (thresholds[k] <= high) {
+                    decided = false;
+                    break;
+                }
+            }
+
+            if (decided) {
+                return band;
+            }
+        }
+
+        int const last = f.octaves - 1;
+        sum += f.amplitude[last] * octave(f.frequency[last]);
+
+        T const value = sum / f.total_amplitude;
+
+        int band = 0;
+        for (int k = 0; k < count; ++k) {
+            if (value > thresholds[k]) {
+                ++band;
+            }
+        }
+        return band;
+    }
+
+    template<typename T>
+    static constexpr auto fbm_progressive(permutation const& perm, T x, fractal<T> const& f, T tolerance) -> T {
+        return progressive_sum(perlin_octave_1d<T> { perm, x }, T(perlin_bound[0]), f, tolerance);
+    }
+
+    template<typename T>
+    static constexpr auto fbm_progressive(permutation const& perm, T x, T y, fractal<T> const& f, T tolerance) -> T {
+        return progressive_sum(perlin_octave_2d<T> { perm, x, y }, T(perlin_bound[1]), f, tolerance);
+    }
+
+    template<typename T>
+    static constexpr auto fbm_progressive(permutation const& perm, T x, T y, T z, fractal<T> const& f, T tolerance) -> T {
+        return progressive_sum(perlin_octave_3d<T> { perm, x, y, z }, T(perlin_bound[2]), f, tolerance);
+    }
+
+    template<typename T>
+    static constexpr auto fbm_classify(permutation const& perm, T x, fractal<T> const& f, T const* thresholds, int count) -> int {
+        return progressive_classify(perlin_octave_1d<T> { perm, x }, T(perlin_bound[0]), f, thresholds, count);
+    }
+
+    template<typename T>
+    static constexpr auto fbm_classify(permutation const& perm, T x, T y, fractal<T> const& f, T const* thresholds, int count) -> int {
+        return progressive_classify(perlin_octave_2d<T> { perm, x, y }, T(perlin_bound[1]), f, thresholds, count);
+    }
+
+    template<typename T>
+    static constexpr auto fbm_classify(permutation const& perm, T x, T y, T z, fractal<T> const& f, T const* thresholds, int count) -> int {
+        return progressive_classify(perlin_octave_3d<T> { perm, x, y, z }, T(perlin_bound[2]), f, thresholds, count);
+    }
+
+    template<typename T>
+    constexpr auto fbm(T x, fractal<T> const& f) -> T {
+        return fbm(default_permutation, x, f);
+    }
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, fractal<T> const& f) -> T {
+        return fbm(default_permutation, x, y, f);
+    }
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, T z, fractal<T> const& f) -> T {
+        return fbm(default_permutation, x, y, z, f);
+    }
+
+    template<typename T>
+    constexpr auto ridged(T x, fractal<T> const& f) -> T {
+        return ridged(default_permutation, x, f);
+    }
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, fractal<T> const& f) -> T {
+        return ridged(default_permutation, x, y, f);
+    }
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, T z, fractal<T> const& f) -> T {
+        return ridged(default_permutation, x, y, z, f);
+    }
+
+    template<typename T>
+    constexpr auto turbulence(T x, fractal<T> const& f) -> T {
+        return turbulence(default_permutation, x, f);
+    }
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, fractal<T> const& f) -> T {
+        return turbulence(default_permutation, x, y, f);
+    }
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, T z, fractal<T> const& f) -> T {
+        return turbulence(default_permutation, x, y, z, f);
+    }
+
+    template<typename T>
+    constexpr auto fbm(T x, int octaves, T lacunarity, T gain) -> T {
+        return fbm(x, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, int octaves, T lacunarity, T gain) -> T {
+        return fbm(x, y, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto fbm(T x, T y, T z, int octaves, T lacunarity, T gain) -> T {
+        return fbm(x, y, z, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto ridged(T x, int octaves, T lacunarity, T gain) -> T {
+        return ridged(x, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, int octaves, T lacunarity, T gain) -> T {
+        return ridged(x, y, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto ridged(T x, T y, T z, int octaves, T lacunarity, T gain) -> T {
+        return ridged(x, y, z, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto turbulence(T x, int octaves, T lacunarity, T gain) -> T {
+        return turbulence(x, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, int octaves, T lacunarity, T gain) -> T {
+        return turbulence(x, y, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto turbulence(T x, T y, T z, int octaves, T lacunarity, T gain) -> T {
+        return turbulence(x, y, z, fractal<T> { octaves, lacunarity, gain });
+    }
+
+    template<typename T>
+    constexpr auto fbm_periodic(T x, int px, fractal<T> const& f) -> T {
+        return fbm_periodic(default_permutation, x, px, f);
+    }
+
+    template<typename T>
+    constexpr auto fbm_periodic(T x, T y, int px, int py, fractal<T> const& f) -> T {
+        return fbm_periodic(default_permutation, x, y, px, py, f);
+    }
+
+    template<typename T>
+    constexpr auto fbm_periodic(T x, T y, T z, int px, int py, int pz, fractal<T> const& f) -> T {
+        return fbm_periodic(default_permutation, x, y, z, px, py, pz, f);
+    }
+
+    template<typename T>
+    constexpr auto fbm_progressive(T x, fractal<T> const& f, T tolerance) -> T {
+        return fbm_progressive(default_permutation, x, f, tolerance);
+    }
+
+    template<typename T>
+    constexpr auto fbm_progressive(T x, T y, fractal<T> const& f, T tolerance) -> T {
+        return fbm_progressive(default_permutation, x, y, f, tolerance);
+    }
+
+    template<typename T>
+    constexpr auto fbm_progressive(T x, T y, T z, fractal<T> const& f, T tolerance) -> T {
+        return fbm_progressive(default_permutation, x, y, z, f, tolerance);
+    }
+
+    template<typename T>
+    constexpr auto fbm_classify(T x, fractal<T> const& f, T const* thresholds, int count) -> int {
+        return fbm_classify(default_permutation, x, f, thresholds, count);
+    }
+
+    template<typename T>
+    constexpr auto fbm_classify(T x, T y, fractal<T> const& f, T const* thresholds, int count) -> int {
+        return fbm_classify(default_permutation, x, y, f, thresholds, count);
+    }
+
+    template<typename T>
+    constexpr auto fbm_classify(T x, T y, T z, fractal<T> const& f, T const* thresholds, int count) -> int {
+        return fbm_classify(default_permutation, x, y, z, f, thresholds, count);
+    }
+
+    // Sums up the octaves of fractal noise over a grid whose rows are `stride` elements apart.
+    // Each octave is a regular grid fill, so the hashes and fade values are still shared between
+    // neighbouring samples within every octave.
+    template<typename T>
+    static auto fbm_fill_2d(permutation const& perm, T* out, long long stride, int width, int height, T x0, T y0, T step, fractal<T> const& f) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "fbm_fill_2d", 2, static_cast<long long>(width) * height * f.octaves);
+        for (int i = 0; i < f.octaves; ++i) {
+            T const frequency = f.frequency[i];
+            fill_2d(perm, out, stride, width, height, x0 * frequency, y0 * frequency, step * frequency, f.amplitude[i], i != 0);
+        }
+
+        for (int j = 0; j < height; ++j) {
+            T* const row = out + j * stride;
+            for (int i = 0; i < width; ++i) {
+                row[i] /= f.total_amplitude;
+            }
+        }
+    }
+
+    template<typename T>
+    static auto fbm_fill_3d(permutation const& perm, T* out, int width, int height, int depth, T x0, T y0, T z0, T step, fractal<T> const& f) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "fbm_fill_3d", 3, static_cast<long long>(width) * height * depth * f.octaves);
+        for (int i = 0; i < f.octaves; ++i) {
+            T const frequency = f.frequency[i];
+            fill_3d(perm, out, width, height, depth, x0 * frequency, y0 * frequency, z0 * frequency, step * frequency, f.amplitude[i], i != 0);
+        }
+
+        long long const count = static_cast<long long>(width) * height * depth;
+        for (long long i = 0; i < count; ++i) {
+            out[i] /= f.total_amplitude;
+        }
+    }
+
+    template<typename T>
+    auto fbm_fill_2d(T* out, int width, int height, T x0, T y0, T step, fractal<T> const& f) -> void {
+        fbm_fill_2d(default_permutation, out, width, width, height, x0, y0, step, f);
+    }
+
+    template<typename T>
+    auto fbm_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step, fractal<T> const& f) -> void {
+        fbm_fill_3d(default_permutation, out, width, height, depth, x0, y0, z0, step, f);
+    }
+
+    // The baking functions evaluate the scalar functions sample by sample, so that they remain
+    // usable in constant expressions; a table is then identical to the calls made at run time.
+    template<typename T, int Width>
+    constexpr auto bake_perlin_1d(T x0, T step) -> baked_noise<T, Width> {
+        baked_noise<T, Width> table {};
+        for (int i = 0; i < Width; ++i) {
+            table.data[i] = perlin(x0 + T(i) * step);
+        }
+        return table;
+    }
+
+    template<typename T, int Width, int Height>
+    constexpr auto bake_perlin_2d(T x0, T y0, T step) -> baked_noise<T, Width, Height> {
+        baked_noise<T, Width, Height> table {};
+        for (int j = 0; j < Height; ++j) {
+            for (int i = 0; i < Width; ++i) {
+                table.data[j * Width + i] = perlin(x0 + T(i) * step, y0 + T(j) * step);
+            }
+        }
+        return table;
+    }
+
+    template<typename T, int Width, int Height, int Depth>
+    constexpr auto bake_perlin_3d(T x0, T y0, T z0, T step) -> baked_noise<T, Width, Height, Depth> {
+        baked_noise<T, Width, Height, Depth> table {};
+        for (int k = 0; k < Depth; ++k) {
+            for (int j = 0; j < Height; ++j) {
+                for (int i = 0; i < Width; ++i) {
+                    table.data[(k * Height + j) * Width + i] = perlin(x0 + T(i) * step, y0 + T(j) * step, z0 + T(k) * step);
+                }
+            }
+        }
+        return table;
+    }
+
+    template<typename T, int Width>
+    constexpr auto bake_fbm_1d(T x0, T step, fractal<T> const& f) -> baked_noise<T, Width> {
+        baked_noise<T, Width> table {};
+        for (int i = 0; i < Width; ++i) {
+            table.data[i] = fbm(x0 + T(i) * step, f);
+        }
+        return table;
+    }
+
+    template<typename T, int Width, int Height>
+    constexpr auto bake_fbm_2d(T x0, T y0, T step, fractal<T> const& f) -> baked_noise<T, Width, Height> {
+        baked_noise<T, Width, Height> table {};
+        for (int j = 0; j < Height; ++j) {
+            for (int i = 0; i < Width; ++i) {
+                table.data[j * Width + i] = fbm(x0 + T(i) * step, y0 + T(j) * step, f);
+            }
+        }
+        return table;
+    }
+
+    template<typename T, int Width, int Height, int Depth>
+    constexpr auto bake_fbm_3d(T x0, T y0, T z0, T step, fractal<T> const& f) -> baked_noise<T, Width, Height, Depth> {
+        baked_noise<T, Width, Height, Depth> table {};
+        for (int k = 0; k < Depth; ++k) {
+            for (int j = 0; j < Height; ++j) {
+                for (int i = 0; i < Width; ++i) {
+                    table.data[(k * Height + j) * Width + i] = fbm(x0 + T(i) * step, y0 + T(j) * step, z0 + T(k) * step, f);
+                }
+            }
+        }
+        return table;
+    }
+
+#if DB_PERLIN_SIMD_AVX2
+    // The AVX2 kernels are compiled for the AVX2 target regardless of the compiler flags, and
+    // are only called after checking that the processor actually supports the instructions.
+    #define DB_PERLIN_TARGET_AVX2 __attribute__((target("avx2")))
+
+    static auto cpu_has_avx2() -> bool {
+        return __builtin_cpu_supports("avx2");
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto floor8(__m256 x, __m256i& xi) -> __m256 {
+        // Same as the scalar version: truncate towards zero, then step down for negative inputs.
+        __m256i const t = _mm256_cvttps_epi32(x);
+        __m256i const m = _mm256_castps_si256(_mm256_cmp_ps(x, _mm256_cvtepi32_ps(t), _CMP_LT_OQ));
+        xi = _mm256_add_epi32(t, m);
+        return _mm256_sub_ps(x, _mm256_cvtepi32_ps(xi));
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto fade8(__m256 t) -> __m256 {
+        __m256 const c = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f));
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), c);
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto lerp8(__m256 a, __m256 b, __m256 t) -> __m256 {
+        return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto negate_if8(__m256 x, __m256i h, int bit, int shift) -> __m256 {
+        __m256i const sign = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(bit)), shift);
+        return _mm256_xor_ps(x, _mm256_castsi256_ps(sign));
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto dot_grad8(__m256i h, __m256 xf, __m256 yf) -> __m256 {
+        __m256i const h3 = _mm256_and_si256(h, _mm256_set1_epi32(0x3));
+        __m256 const zero_a = _mm256_castsi256_ps(_mm256_cmpeq_epi32(h3, _mm256_set1_epi32(0x3)));
+        __m256 const zero_b = _mm256_castsi256_ps(_mm256_cmpeq_epi32(h3, _mm256_set1_epi32(0x1)));
+        __m256 const a = negate_if8(_mm256_andnot_ps(zero_a, xf), h, 0x4, 29);
+        __m256 const b = negate_if8(_mm256_andnot_ps(zero_b, yf), _mm256_add_epi32(h, _mm256_set1_epi32(0x2)), 0x4, 29);
+        return _mm256_add_ps(a, b);
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto dot_grad8(__m256i h, __m256 xf, __m256 yf, __m256 zf) -> __m256 {
+        h = _mm256_and_si256(h, _mm256_set1_epi32(0xF));
+        __m256 const lt8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(0x8), h));
+        __m256 const lt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(0x4), h));
+        __m256 const ce = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0xD)), _mm256_set1_epi32(0xC)));
+        __m256 const a = _mm256_blendv_ps(yf, xf, lt8);
+        __m256 const b = _mm256_blendv_ps(_mm256_blendv_ps(zf, xf, ce), yf, lt4);
+        return _mm256_add_ps(negate_if8(a, h, 0x1, 31), negate_if8(b, h, 0x2, 30));
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static inline auto hash8(int const* perm, __m256i i) -> __m256i {
+        return _mm256_i32gather_epi32(perm, i, 4);
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static auto perlin_n_avx2(int const* perm, float const* xs, float const* ys, float* out, std::size_t n) -> std::size_t {
+        __m256i const one = _mm256_set1_epi32(1);
+        __m256i const mask = _mm256_set1_epi32(0xFF);
+
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i xi, yi;
+            __m256 const xf0 = floor8(_mm256_loadu_ps(xs + i), xi);
+            __m256 const yf0 = floor8(_mm256_loadu_ps(ys + i), yi);
+            __m256 const xf1 = _mm256_sub_ps(xf0, _mm256_set1_ps(1.0f));
+            __m256 const yf1 = _mm256_sub_ps(yf0, _mm256_set1_ps(1.0f));
+            xi = _mm256_and_si256(xi, mask);
+            yi = _mm256_and_si256(yi, mask);
+
+            __m256 const u = fade8(xf0);
+            __m256 const v = fade8(yf0);
+
+            __m256i const a = _mm256_add_epi32(hash8(perm, xi), yi);
+            __m256i const b = _mm256_add_epi32(hash8(perm, _mm256_add_epi32(xi, one)), yi);
+            __m256i const h00 = hash8(perm, a);
+            __m256i const h01 = hash8(perm, _mm256_add_epi32(a, one));
+            __m256i const h10 = hash8(perm, b);
+            __m256i const h11 = hash8(perm, _mm256_add_epi32(b, one));
+
+            __m256 const x1 = lerp8(dot_grad8(h00, xf0, yf0), dot_grad8(h10, xf1, yf0), u);
+            __m256 const x2 = lerp8(dot_grad8(h01, xf0, yf1), dot_grad8(h11, xf1, yf1), u);
+            _mm256_storeu_ps(out + i, lerp8(x1, x2, v));
+        }
+
+        return i;
+    }
+
+    DB_PERLIN_TARGET_AVX2
+    static auto perlin_n_avx2(int const* perm, float const* xs, float const* ys, float const* zs, float* out, std::size_t n) -> std::size_t {
+        __m256i const one = _mm256_set1_epi32(1);
+        __m256i const mask = _mm256_set1_epi32(0xFF);
+
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i xi, yi, zi;
+            __m256 const xf0 = floor8(_mm256_loadu_ps(xs + i), xi);
+            __m256 const yf0 = floor8(_mm256_loadu_ps(ys + i), yi);
+            __m256 const zf0 = floor8(_mm256_loadu_ps(zs + i), zi);
+            __m256 const xf1 = _mm256_sub_ps(xf0, _mm256_set1_ps(1.0f));
+            __m256 const yf1 = _mm256_sub_ps(yf0, _mm256_set1_ps(1.0f));
+            __m256 const zf1 = _mm256_sub_ps(zf0, _mm256_set1_ps(1.0f));
+            xi = _mm256_and_si256(xi, mask);
+            yi = _mm256_and_si256(yi, mask);
+            zi = _mm256_and_si256(zi, mask);
+
+            __m256 const u = fade8(xf0);
+            __m256 const v = fade8(yf0);
+            __m256 const w = fade8(zf0);
+
+            __m256i const a = _mm256_add_epi32(hash8(perm, xi), yi);
+            __m256i const b = _mm256_add_epi32(hash8(perm, _mm256_add_epi32(xi, one)), yi);
+            __m256i const aa = _mm256_add_epi32(hash8(perm, a), zi);
+            __m256i const ab = _mm256_add_epi32(hash8(perm, _mm256_add_epi32(a, one)), zi);
+            __m256i const ba = _mm256_add_epi32(hash8(perm, b), zi);
+            __m256i const bb = _mm256_add_epi32(hash8(perm, _mm256_add_epi32(b, one)), zi);
+
+            __m256 const x11 = lerp8(dot_grad8(hash8(perm, aa), xf0, yf0, zf0), dot_grad8(hash8(perm, ba), xf1, yf0, zf0), u);
+            __m256 const x12 = lerp8(dot_grad8(hash8(perm, ab), xf0, yf1, zf0), dot_grad8(hash8(perm, bb), xf1, yf1, zf0), u);
+            __m256 const x21 = lerp8(dot_grad8(hash8(perm, _mm256_add_epi32(aa, one)), xf0, yf0, zf1), dot_grad8(hash8(perm, _mm256_add_epi32(ba, one)), xf1, yf0, zf1), u);
+            __m256 const x22 = lerp8(dot_grad8(hash8(perm, _mm256_add_epi32(ab, one)), xf0, yf1, zf1), dot_grad8(hash8(perm, _mm256_add_epi32(bb, one)), xf1, yf1, zf1), u);
+
+            __m256 const y1 = lerp8(x11, x12, v);
+            __m256 const y2 = lerp8(x21, x22, v);
+            _mm256_storeu_ps(out + i, lerp8(y1, y2, w));
+        }
+
+        return i;
+    }
+
+    #undef DB_PERLIN_TARGET_AVX2
+#endif // DB_PERLIN_SIMD_AVX2
+
+#if DB_PERLIN_SIMD_SSE2
+    static inline auto floor4(__m128 x, __m128i& xi) -> __m128 {
+        // Same as the scalar version: truncate towards zero, then step down for negative inputs.
+        __m128i const t = _mm_cvttps_epi32(x);
+        __m128i const m = _mm_castps_si128(_mm_cmplt_ps(x, _mm_cvtepi32_ps(t)));
+        xi = _mm_add_epi32(t, m);
+        return _mm_sub_ps(x, _mm_cvtepi32_ps(xi));
+    }
+
+    static inline auto fade4(__m128 t) -> __m128 {
+        __m128 const c = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+        return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), c);
+    }
+
+    static inline auto lerp4(__m128 a, __m128 b, __m128 t) -> __m128 {
+        return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+    }
+
+    static inline auto select4(__m128 mask, __m128 a, __m128 b) -> __m128 {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    static inline auto negate_if4(__m128 x, __m128i h, int bit, int shift) -> __m128 {
+        __m128i const sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(bit)), shift);
+        return _mm_xor_ps(x, _mm_castsi128_ps(sign));
+    }
+
+    static inline auto dot_grad4(__m128i h, __m128 xf, __m128 yf) -> __m128 {
+        __m128i const h3 = _mm_and_si128(h, _mm_set1_epi32(0x3));
+        __m128 const zero_a = _mm_castsi128_ps(_mm_cmpeq_epi32(h3, _mm_set1_epi32(0x3)));
+        __m128 const zero_b = _mm_castsi128_ps(_mm_cmpeq_epi32(h3, _mm_set1_epi32(0x1)));
+        __m128 const a = negate_if4(_mm_andnot_ps(zero_a, xf), h, 0x4, 29);
+        __m128 const b = negate_if4(_mm_andnot_ps(zero_b, yf), _mm_add_epi32(h, _mm_set1_epi32(0x2)), 0x4, 29);
+        return _mm_add_ps(a, b);
+    }
+
+    static inline auto dot_grad4(__m128i h, __m128 xf, __m128 yf, __m128 zf) -> __m128 {
+        h = _mm_and_si128(h, _mm_set1_epi32(0xF));
+        __m128 const lt8 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(0x8)));
+        __m128 const lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(0x4)));
+        __m128 const ce = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(0xD)), _mm_set1_epi32(0xC)));
+        __m128 const a = select4(lt8, xf, yf);
+        __m128 const b = select4(lt4, yf, select4(ce, xf, zf));
+        return _mm_add_ps(negate_if4(a, h, 0x1, 31), negate_if4(b, h, 0x2, 30));
+    }
+
+    static inline auto hash4(int const* perm, __m128i i) -> __m128i {
+        // SSE2 has no gather instruction, so the lanes are looked up one by one.
+        alignas(16) int lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), i);
+        return _mm_setr_epi32(perm[lanes[0]], perm[lanes[1]], perm[lanes[2]], perm[lanes[3]]);
+    }
+
+    static auto perlin_n_sse2(int const* perm, float const* xs, float const* ys, float* out, std::size_t n) -> std::size_t {
+        __m128i const one = _mm_set1_epi32(1);
+        __m128i const mask = _mm_set1_epi32(0xFF);
+
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i xi, yi;
+            __m128 const xf0 = floor4(_mm_loadu_ps(xs + i), xi);
+            __m128 const yf0 = floor4(_mm_loadu_ps(ys + i), yi);
+            __m128 const xf1 = _mm_sub_ps(xf0, _mm_set1_ps(1.0f));
+            __m128 const yf1 = _mm_sub_ps(yf0, _mm_set1_ps(1.0f));
+            xi = _mm_and_si128(xi, mask);
+            yi = _mm_and_si128(yi, mask);
+
+            __m128 const u = fade4(xf0);
+            __m128 const v = fade4(yf0);
+
+            __m128i const a = _mm_add_epi32(hash4(perm, xi), yi);
+            __m128i const b = _mm_add_epi32(hash4(perm, _mm_add_epi32(xi, one)), yi);
+            __m128i const h00 = hash4(perm, a);
+            __m128i const h01 = hash4(perm, _mm_add_epi32(a, one));
+            __m128i const h10 = hash4(perm, b);
+            __m128i const h11 = hash4(perm, _mm_add_epi32(b, one));
+
+            __m128 const x1 = lerp4(dot_grad4(h00, xf0, yf0), dot_grad4(h10, xf1, yf0), u);
+            __m128 const x2 = lerp4(dot_grad4(h01, xf0, yf1), dot_grad4(h11, xf1, yf1), u);
+            _mm_storeu_ps(out + i, lerp4(x1, x2, v));
+        }
+
+        return i;
+    }
+
+    static auto perlin_n_sse2(int const* perm, float const* xs, float const* ys, float const* zs, float* out, std::size_t n) -> std::size_t {
+        __m128i const one = _mm_set1_epi32(1);
+        __m128i const mask = _mm_set1_epi32(0xFF);
+
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i xi, yi, zi;
+            __m128 const xf0 = floor4(_mm_loadu_ps(xs + i), xi);
+            __m128 const yf0 = floor4(_mm_loadu_ps(ys + i), yi);
+            __m128 const zf0 = floor4(_mm_loadu_ps(zs + i), zi);
+            __m128 const xf1 = _mm_sub_ps(xf0, _mm_set1_ps(1.0f));
+            __m128 const yf1 = _mm_sub_ps(yf0, _mm_set1_ps(1.0f));
+            __m128 const zf1 = _mm_sub_ps(zf0, _mm_set1_ps(1.0f));
+            xi = _mm_and_si128(xi, mask);
+            yi = _mm_and_si128(yi, mask);
+            zi = _mm_and_si128(zi, mask);
+
+            __m128 const u = fade4(xf0);
+            __m128 const v = fade4(yf0);
+            __m128 const w = fade4(zf0);
+
+            __m128i const a = _mm_add_epi32(hash4(perm, xi), yi);
+            __m128i const b = _mm_add_epi32(hash4(perm, _mm_add_epi32(xi, one)), yi);
+            __m128i const aa = _mm_add_epi32(hash4(perm, a), zi);
+            __m128i const ab = _mm_add_epi32(hash4(perm, _mm_add_epi32(a, one)), zi);
+            __m128i const ba = _mm_add_epi32(hash4(perm, b), zi);
+            __m128i const bb = _mm_add_epi32(hash4(perm, _mm_add_epi32(b, one)), zi);
+
+            __m128 const x11 = lerp4(dot_grad4(hash4(perm, aa), xf0, yf0, zf0), dot_grad4(hash4(perm, ba), xf1, yf0, zf0), u);
+            __m128 const x12 = lerp4(dot_grad4(hash4(perm, ab), xf0, yf1, zf0), dot_grad4(hash4(perm, bb), xf1, yf1, zf0), u);
+            __m128 const x21 = lerp4(dot_grad4(hash4(perm, _mm_add_epi32(aa, one)), xf0, yf0, zf1), dot_grad4(hash4(perm, _mm_add_epi32(ba, one)), xf1, yf0, zf1), u);
+            __m128 const x22 = lerp4(dot_grad4(hash4(perm, _mm_add_epi32(ab, one)), xf0, yf1, zf1), dot_grad4(hash4(perm, _mm_add_epi32(bb, one)), xf1, yf1, zf1), u);
+
+            __m128 const y1 = lerp4(x11, x12, v);
+            __m128 const y2 = lerp4(x21, x22, v);
+            _mm_storeu_ps(out + i, lerp4(y1, y2, w));
+        }
+
+        return i;
+    }
+#endif // DB_PERLIN_SIMD_SSE2
+
+#if DB_PERLIN_SIMD_NEON
+    static inline auto floor4(float32x4_t x, int32x4_t& xi) -> float32x4_t {
+        // Same as the scalar version: truncate towards zero, then step down for negative inputs.
+        int32x4_t const t = vcvtq_s32_f32(x);
+        int32x4_t const m = vreinterpretq_s32_u32(vcltq_f32(x, vcvtq_f32_s32(t)));
+        xi = vaddq_s32(t, m);
+        return vsubq_f32(x, vcvtq_f32_s32(xi));
+    }
+
+    static inline auto fade4(float32x4_t t) -> float32x4_t {
+        float32x4_t const c = vaddq_f32(vmulq_f32(t, vsubq_f32(vmulq_f32(t, vdupq_n_f32(6.0f)), vdupq_n_f32(15.0f))), vdupq_n_f32(10.0f));
+        return vmulq_f32(vmulq_f32(vmulq_f32(t, t), t), c);
+    }
+
+    static inline auto lerp4(float32x4_t a, float32x4_t b, float32x4_t t) -> float32x4_t {
+        return vaddq_f32(a, vmulq_f32(t, vsubq_f32(b, a)));
+    }
+
+    static inline auto negate_if4(float32x4_t x, int32x4_t h, int bit, int shift) -> float32x4_t {
+        uint32x4_t const sign = vshlq_u32(vreinterpretq_u32_s32(vandq_s32(h, vdupq_n_s32(bit))), vdupq_n_s32(shift));
+        return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(x), sign));
+    }
+
+    static inline auto zero_if4(float32x4_t x, uint32x4_t mask) -> float32x4_t {
+        return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(x), mask));
+    }
+
+    static inline auto dot_grad4(int32x4_t h, float32x4_t xf, float32x4_t yf) -> float32x4_t {
+        int32x4_t const h3 = vandq_s32(h, vdupq_n_s32(0x3));
+        float32x4_t const a = negate_if4(zero_if4(xf, vceqq_s32(h3, vdupq_n_s32(0x3))), h, 0x4, 29);
+        float32x4_t const b = negate_if4(zero_if4(yf, vceqq_s32(h3, vdupq_n_s32(0x1))), vaddq_s32(h, vdupq_n_s32(0x2)), 0x4, 29);
+        return vaddq_f32(a, b);
+    }
+
+    static inline auto dot_grad4(int32x4_t h, float32x4_t xf, float32x4_t yf, float32x4_t zf) -> float32x4_t {
+        h = vandq_s32(h, vdupq_n_s32(0xF));
+        uint32x4_t const lt8 = vcltq_s32(h, vdupq_n_s32(0x8));
+        uint32x4_t const lt4 = vcltq_s32(h, vdupq_n_s32(0x4));
+        uint32x4_t const ce = vceqq_s32(vandq_s32(h, vdupq_n_s32(0xD)), vdupq_n_s32(0xC));
+        float32x4_t const a = vbslq_f32(lt8, xf, yf);
+        float32x4_t const b = vbslq_f32(lt4, yf, vbslq_f32(ce, xf, zf));
+        return vaddq_f32(negate_if4(a, h, 0x1, 31), negate_if4(b, h, 0x2, 30));
+    }
+
+    static inline auto hash4(int const* perm, int32x4_t i) -> int32x4_t {
+        // NEON has no gather instruction, so the lanes are looked up one by one.
+        int lanes[4];
+        vst1q_s32(lanes, i);
+        int const values[4] = { perm[lanes[0]], perm[lanes[1]], perm[lanes[2]], perm[lanes[3]] };
+        return vld1q_s32(values);
+    }
+
+    static auto perlin_n_neon(int const* perm, float const* xs, float const* ys, float* out, std::size_t n) -> std::size_t {
+        int32x4_t const one = vdupq_n_s32(1);
+        int32x4_t const mask = vdupq_n_s32(0xFF);
+
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int32x4_t xi, yi;
+            float32x4_t const xf0 = floor4(vld1q_f32(xs + i), xi);
+            float32x4_t const yf0 = floor4(vld1q_f32(ys + i), yi);
+            float32x4_t const xf1 = vsubq_f32(xf0, vdupq_n_f32(1.0f));
+            float32x4_t const yf1 = vsubq_f32(yf0, vdupq_n_f32(1.0f));
+            xi = vandq_s32(xi, mask);
+            yi = vandq_s32(yi, mask);
+
+            float32x4_t const u = fade4(xf0);
+            float32x4_t const v = fade4(yf0);
+
+            int32x4_t const a = vaddq_s32(hash4(perm, xi), yi);
+            int32x4_t const b = vaddq_s32(hash4(perm, vaddq_s32(xi, one)), yi);
+            int32x4_t const h00 = hash4(perm, a);
+            int32x4_t const h01 = hash4(perm, vaddq_s32(a, one));
+            int32x4_t const h10 = hash4(perm, b);
+            int32x4_t const h11 = hash4(perm, vaddq_s32(b, one));
+
+            float32x4_t const x1 = lerp4(dot_grad4(h00, xf0, yf0), dot_grad4(h10, xf1, yf0), u);
+            float32x4_t const x2 = lerp4(dot_grad4(h01, xf0, yf1), dot_grad4(h11, xf1, yf1), u);
+            vst1q_f32(out + i, lerp4(x1, x2, v));
+        }
+
+        return i;
+    }
+
+    static auto perlin_n_neon(int const* perm, float const* xs, float const* ys, float const* zs, float* out, std::size_t n) -> std::size_t {
+        int32x4_t const one = vdupq_n_s32(1);
+        int32x4_t const mask = vdupq_n_s32(0xFF);
+
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            int32x4_t xi, yi, zi;
+            float32x4_t const xf0 = floor4(vld1q_f32(xs + i), xi);
+            float32x4_t const yf0 = floor4(vld1q_f32(ys + i), yi);
+            float32x4_t const zf0 = floor4(vld1q_f32(zs + i), zi);
+            float32x4_t const xf1 = vsubq_f32(xf0, vdupq_n_f32(1.0f));
+            float32x4_t const yf1 = vsubq_f32(yf0, vdupq_n_f32(1.0f));
+            float32x4_t const zf1 = vsubq_f32(zf0, vdupq_n_f32(1.0f));
+            xi = vandq_s32(xi, mask);
+            yi = vandq_s32(yi, mask);
+            zi = vandq_s32(zi, mask);
+
+            float32x4_t const u = fade4(xf0);
+            float32x4_t const v = fade4(yf0);
+            float32x4_t const w = fade4(zf0);
+
+            int32x4_t const a = vaddq_s32(hash4(perm, xi), yi);
+            int32x4_t const b = vaddq_s32(hash4(perm, vaddq_s32(xi, one)), yi);
+            int32x4_t const aa = vaddq_s32(hash4(perm, a), zi);
+            int32x4_t const ab = vaddq_s32(hash4(perm, vaddq_s32(a, one)), zi);
+            int32x4_t const ba = vaddq_s32(hash4(perm, b), zi);
+            int32x4_t const bb = vaddq_s32(hash4(perm, vaddq_s32(b, one)), zi);
+
+            float32x4_t const x11 = lerp4(dot_grad4(hash4(perm, aa), xf0, yf0, zf0), dot_grad4(hash4(perm, ba), xf1, yf0, zf0), u);
+            float32x4_t const x12 = lerp4(dot_grad4(hash4(perm, ab), xf0, yf1, zf0), dot_grad4(hash4(perm, bb), xf1, yf1, zf0), u);
+            float32x4_t const x21 = lerp4(dot_grad4(hash4(perm, vaddq_s32(aa, one)), xf0, yf0, zf1), dot_grad4(hash4(perm, vaddq_s32(ba, one)), xf1, yf0, zf1), u);
+            float32x4_t const x22 = lerp4(dot_grad4(hash4(perm, vaddq_s32(ab, one)), xf0, yf1, zf1), dot_grad4(hash4(perm, vaddq_s32(bb, one)), xf1, yf1, zf1), u);
+
+            float32x4_t const y1 = lerp4(x11, x12, v);
+            float32x4_t const y2 = lerp4(x21, x22, v);
+            vst1q_f32(out + i, lerp4(y1, y2, w));
+        }
+
+        return i;
+    }
+#endif // DB_PERLIN_SIMD_NEON
+
+    // Evaluates as many leading samples as possible with the widest kernel available, and
+    // returns how many were processed. The remainder is left for the scalar path.
+    static inline auto perlin_n_simd(int const* perm, float const* xs, float const* ys, float* out, std::size_t n) -> std::size_t {
+        std::size_t i = 0;
+#if DB_PERLIN_SIMD_AVX2
+        if (cpu_has_avx2()) {
+            i += perlin_n_avx2(perm, xs + i, ys + i, out + i, n - i);
+        }
+#endif
+#if DB_PERLIN_SIMD_SSE2
+        i += perlin_n_sse2(perm, xs + i, ys + i, out + i, n - i);
+#endif
+#if DB_PERLIN_SIMD_NEON
+        i += perlin_n_neon(perm, xs + i, ys + i, out + i, n - i);
+#endif
+        (void) perm; (void) xs; (void) ys; (void) out; (void) n;
+        return i;
+    }
+
+    static inline auto perlin_n_simd(int const* perm, float const* xs, float const* ys, float const* zs, float* out, std::size_t n) -> std::size_t {
+        std::size_t i = 0;
+#if DB_PERLIN_SIMD_AVX2
+        if (cpu_has_avx2()) {
+            i += perlin_n_avx2(perm, xs + i, ys + i, zs + i, out + i, n - i);
+        }
+#endif
+#if DB_PERLIN_SIMD_SSE2
+        i += perlin_n_sse2(perm, xs + i, ys + i, zs + i, out + i, n - i);
+#endif
+#if DB_PERLIN_SIMD_NEON
+        i += perlin_n_neon(perm, xs + i, ys + i, zs + i, out + i, n - i);
+#endif
+        (void) perm; (void) xs; (void) ys; (void) zs; (void) out; (void) n;
+        return i;
+    }
+
+    // There are no vectorized kernels for doubles, they always take the scalar path.
+    static inline auto perlin_n_simd(int const*, double const*, double const*, double*, std::size_t) -> std::size_t {
+        return 0;
+    }
+
+    static inline auto perlin_n_simd(int const*, double const*, double const*, double const*, double*, std::size_t) -> std::size_t {
+        return 0;
+    }
+
+    template<typename T>
+    static auto perlin_n(permutation const& perm, T const* xs, T* out, std::size_t n) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_n", 1, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = perlin_scalar(perm, xs[i]);
+        }
+    }
+
+    template<typename T>
+    static auto perlin_n(permutation const& perm, T const* xs, T const* ys, T* out, std::size_t n) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_n", 2, n);
+        for (std::size_t i = perlin_n_simd(perm.p32, xs, ys, out, n); i < n; ++i) {
+            out[i] = perlin_scalar(perm, xs[i], ys[i]);
+        }
+    }
+
+    template<typename T>
+    static auto perlin_n(permutation const& perm, T const* xs, T const* ys, T const* zs, T* out, std::size_t n) -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_n", 3, n);
+        for (std::size_t i = perlin_n_simd(perm.p32, xs, ys, zs, out, n); i < n; ++i) {
+            out[i] = perlin_scalar(perm, xs[i], ys[i], zs[i]);
+        }
+    }
+
+    template<typename T>
+    auto perlin_n(T const* xs, T* out, std::size_t n) -> void {
+        perlin_n(default_permutation, xs, out, n);
+    }
+
+    template<typename T>
+    auto perlin_n(T const* xs, T const* ys, T* out, std::size_t n) -> void {
+        perlin_n(default_permutation, xs, ys, out, n);
+    }
+
+    template<typename T>
+    auto perlin_n(T const* xs, T const* ys, T const* zs, T* out, std::size_t n) -> void {
+        perlin_n(default_permutation, xs, ys, zs, out, n);
+    }
+
+    // Fisher-Yates shuffle of the identity permutation, driven by a SplitMix64 sequence. The
+    // sequence is fully specified, so a seed produces the same noise on every platform.
+    static auto splitmix64(std::uint64_t& state) -> std::uint64_t {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    DB_PERLIN_INLINE perlin_generator::perlin_generator(std::uint64_t seed) : m_seed { seed }, m_permutation {} {
+        unsigned char values[256] = {};
+        for (int i = 0; i < 256; ++i) {
+            values[i] = static_cast<unsigned char>(i);
+        }
+
+        std::uint64_t state = seed;
+        for (int i = 255; i > 0; --i) {
+            int const j = int(splitmix64(state) % std::uint64_t(i + 1));
+            unsigned char const t = values[i];
+            values[i] = values[j];
+            values[j] = t;
+        }
+
+        for (int i = 0; i < 512; ++i) {
+            m_permutation.p[i] = values[i & 0xFF];
+            m_permutation.p32[i] = values[i & 0xFF];
+        }
+    }
+
+    DB_PERLIN_INLINE auto perlin_generator::seed() const -> std::uint64_t {
+        return m_seed;
+    }
+
+    DB_PERLIN_INLINE auto perlin_generator::table() const -> permutation const& {
+        return m_permutation;
+    }
+
+    template<typename T>
+    auto perlin_generator::perlin(T x) const -> T {
+        return db::perlin(m_permutation, x);
+    }
 
-namespace db {
     template<typename T>
-    constexpr auto perlin(T x) -> T;
+    auto perlin_generator::perlin(T x, T y) const -> T {
+        return db::perlin(m_permutation, x, y);
+    }
 
     template<typename T>
-    constexpr auto perlin(T x, T y) -> T;
+    auto perlin_generator::perlin(T x, T y, T z) const -> T {
+        return db::perlin(m_permutation, x, y, z);
+    }
 
     template<typename T>
-    constexpr auto perlin(T x, T y, T z) -> T;
-}
+    auto perlin_generator::simplex(T x) const -> T {
+        return db::simplex(m_permutation, x);
+    }
 
-#ifdef DB_PERLIN_IMPL
+    template<typename T>
+    auto perlin_generator::simplex(T x, T y) const -> T {
+        return db::simplex(m_permutation, x, y);
+    }
 
-/*
- * The implementation was based on this article:
- * - https://flafla2.github.io/2014/08/09/perlinnoise.html
- *
- * A reference implementation in Java by Ken Perlin, the author of the algorithm:
- * - https://mrl.cs.nyu.edu/~perlin/noise/
- *
- * Here are some alternative implementations that were used as inspirations:
- * - https://github.com/nothings/stb/blob/master/stb_perlin.h
- * - https://github.com/stegu/perlin-noise/blob/master/src/noise1234.c
- */
+    template<typename T>
+    auto perlin_generator::simplex(T x, T y, T z) const -> T {
+        return db::simplex(m_permutation, x, y, z);
+    }
 
-namespace db {
-    // Permutation table, the second half is a mirror of the first half.
-    static constexpr unsigned char p[512] = {
-        0x97, 0xA0, 0x89, 0x5B, 0x5A, 0x0F, 0x83, 0x0D, 0xC9, 0x5F, 0x60, 0x35, 0xC2, 0xE9, 0x07, 0xE1,
-        0x8C, 0x24, 0x67, 0x1E, 0x45, 0x8E, 0x08, 0x63, 0x25, 0xF0, 0x15, 0x0A, 0x17, 0xBE, 0x06, 0x94,
-        0xF7, 0x78, 0xEA, 0x4B, 0x00, 0x1A, 0xC5, 0x3E, 0x5E, 0xFC, 0xDB, 0xCB, 0x75, 0x23, 0x0B, 0x20,
-        0x39, 0xB1, 0x21, 0x58, 0xED, 0x95, 0x38, 0x57, 0xAE, 0x14, 0x7D, 0x88, 0xAB, 0xA8, 0x44, 0xAF,
-        0x4A, 0xA5, 0x47, 0x86, 0x8B, 0x30, 0x1B, 0xA6, 0x4D, 0x92, 0x9E, 0xE7, 0x53, 0x6F, 0xE5, 0x7A,
-        0x3C, 0xD3, 0x85, 0xE6, 0xDC, 0x69, 0x5C, 0x29, 0x37, 0x2E, 0xF5, 0x28, 0xF4, 0x66, 0x8F, 0x36,
-        0x41, 0x19, 0x3F, 0xA1, 0x01, 0xD8, 0x50, 0x49, 0xD1, 0x4C, 0x84, 0xBB, 0xD0, 0x59, 0x12, 0xA9,
-        0xC8, 0xC4, 0x87, 0x82, 0x74, 0xBC, 0x9F, 0x56, 0xA4, 0x64, 0x6D, 0xC6, 0xAD, 0xBA, 0x03, 0x40,
-        0x34, 0xD9, 0xE2, 0xFA, 0x7C, 0x7B, 0x05, 0xCA, 0x26, 0x93, 0x76, 0x7E, 0xFF, 0x52, 0x55, 0xD4,
-        0xCF, 0xCE, 0x3B, 0xE3, 0x2F, 0x10, 0x3A, 0x11, 0xB6, 0xBD, 0x1C, 0x2A, 0xDF, 0xB7, 0xAA, 0xD5,
-        0x77, 0xF8, 0x98, 0x02, 0x2C, 0x9A, 0xA3, 0x46, 0xDD, 0x99, 0x65, 0x9B, 0xA7, 0x2B, 0xAC, 0x09,
-        0x81, 0x16, 0x27, 0xFD, 0x13, 0x62, 0x6C, 0x6E, 0x4F, 0x71, 0xE0, 0xE8, 0xB2, 0xB9, 0x70, 0x68,
-        0xDA, 0xF6, 0x61, 0xE4, 0xFB, 0x22, 0xF2, 0xC1, 0xEE, 0xD2, 0x90, 0x0C, 0xBF, 0xB3, 0xA2, 0xF1,
-        0x51, 0x33, 0x91, 0xEB, 0xF9, 0x0E, 0xEF, 0x6B, 0x31, 0xC0, 0xD6, 0x1F, 0xB5, 0xC7, 0x6A, 0x9D,
-        0xB8, 0x54, 0xCC, 0xB0, 0x73, 0x79, 0x32, 0x2D, 0x7F, 0x04, 0x96, 0xFE, 0x8A, 0xEC, 0xCD, 0x5D,
-        0xDE, 0x72, 0x43, 0x1D, 0x18, 0x48, 0xF3, 0x8D, 0x80, 0xC3, 0x4E, 0x42, 0xD7, 0x3D, 0x9C, 0xB4,
+    template<typename T>
+    auto perlin_generator::simplex(T x, T y, T z, T w) const -> T {
+        return db::simplex(m_permutation, x, y, z, w);
+    }
 
-        0x97, 0xA0, 0x89, 0x5B, 0x5A, 0x0F, 0x83, 0x0D, 0xC9, 0x5F, 0x60, 0x35, 0xC2, 0xE9, 0x07, 0xE1,
-        0x8C, 0x24, 0x67, 0x1E, 0x45, 0x8E, 0x08, 0x63, 0x25, 0xF0, 0x15, 0x0A, 0x17, 0xBE, 0x06, 0x94,
-        0xF7, 0x78, 0xEA, 0x4B, 0x00, 0x1A, 0xC5, 0x3E, 0x5E, 0xFC, 0xDB, 0xCB, 0x75, 0x23, 0x0B, 0x20,
-        0x39, 0xB1, 0x21, 0x58, 0xED, 0x95, 0x38, 0x57, 0xAE, 0x14, 0x7D, 0x88, 0xAB, 0xA8, 0x44, 0xAF,
-        0x4A, 0xA5, 0x47, 0x86, 0x8B, 0x30, 0x1B, 0xA6, 0x4D, 0x92, 0x9E, 0xE7, 0x53, 0x6F, 0xE5, 0x7A,
-        0x3C, 0xD3, 0x85, 0xE6, 0xDC, 0x69, 0x5C, 0x29, 0x37, 0x2E, 0xF5, 0x28, 0xF4, 0x66, 0x8F, 0x36,
-        0x41, 0x19, 0x3F, 0xA1, 0x01, 0xD8, 0x50, 0x49, 0xD1, 0x4C, 0x84, 0xBB, 0xD0, 0x59, 0x12, 0xA9,
-        0xC8, 0xC4, 0x87, 0x82, 0x74, 0xBC, 0x9F, 0x56, 0xA4, 0x64, 0x6D, 0xC6, 0xAD, 0xBA, 0x03, 0x40,
-        0x34, 0xD9, 0xE2, 0xFA, 0x7C, 0x7B, 0x05, 0xCA, 0x26, 0x93, 0x76, 0x7E, 0xFF, 0x52, 0x55, 0xD4,
-        0xCF, 0xCE, 0x3B, 0xE3, 0x2F, 0x10, 0x3A, 0x11, 0xB6, 0xBD, 0x1C, 0x2A, 0xDF, 0xB7, 0xAA, 0xD5,
-        0x77, 0xF8, 0x98, 0x02, 0x2C, 0x9A, 0xA3, 0x46, 0xDD, 0x99, 0x65, 0x9B, 0xA7, 0x2B, 0xAC, 0x09,
-        0x81, 0x16, 0x27, 0xFD, 0x13, 0x62, 0x6C, 0x6E, 0x4F, 0x71, 0xE0, 0xE8, 0xB2, 0xB9, 0x70, 0x68,
-        0xDA, 0xF6, 0x61, 0xE4, 0xFB, 0x22, 0xF2, 0xC1, 0xEE, 0xD2, 0x90, 0x0C, 0xBF, 0xB3, 0xA2, 0xF1,
-        0x51, 0x33, 0x91, 0xEB, 0xF9, 0x0E, 0xEF, 0x6B, 0x31, 0xC0, 0xD6, 0x1F, 0xB5, 0xC7, 0x6A, 0x9D,
-        0xB8, 0x54, 0xCC, 0xB0, 0x73, 0x79, 0x32, 0x2D, 0x7F, 0x04, 0x96, 0xFE, 0x8A, 0xEC, 0xCD, 0x5D,
-        0xDE, 0x72, 0x43, 0x1D, 0x18, 0x48, 0xF3, 0x8D, 0x80, 0xC3, 0x4E, 0x42, 0xD7, 0x3D, 0x9C, 0xB4,
-    };
+    template<typename T>
+    auto perlin_generator::perlin_periodic(T x, int px) const -> T {
+        return db::perlin_periodic(m_permutation, x, px);
+    }
 
     template<typename T>
-    static constexpr auto lerp(T a, T b, T t) -> T {
-        return a + t * (b - a);
+    auto perlin_generator::perlin_periodic(T x, T y, int px, int py) const -> T {
+        return db::perlin_periodic(m_permutation, x, y, px, py);
     }
 
     template<typename T>
-    static constexpr auto floor(T x) -> int {
-        auto const xi = int(x);
-        return (x < T(xi)) ? xi - 1 : xi;
+    auto perlin_generator::perlin_periodic(T x, T y, T z, int px, int py, int pz) const -> T {
+        return db::perlin_periodic(m_permutation, x, y, z, px, py, pz);
     }
 
     template<typename T>
-    static constexpr auto fade(T t) -> T {
-        return t * t * t * (t * (t * T(6.0) - T(15.0)) + T(10.0));
+    auto perlin_generator::perlin_d(T x) const -> noise_gradient<T> {
+        return db::perlin_d(m_permutation, x);
     }
 
     template<typename T>
-    static constexpr auto dot_grad(int hash, T xf) -> T {
-        // In 1D case, the gradient may be either 1 or -1.
-        // The distance vector is the input offset (relative to the smallest bound).
-        return (hash & 0x1) ? xf : -xf;
+    auto perlin_generator::perlin_d(T x, T y) const -> noise_gradient<T> {
+        return db::perlin_d(m_permutation, x, y);
     }
 
     template<typename T>
-    static constexpr auto dot_grad(int hash, T xf, T yf) -> T {
-        // In 2D case, the gradient may be any of 8 direction vectors pointing to the
-        // edges of a unit-square. The distance vector is the input offset (relative to
-        // the smallest bound).
-        switch (hash & 0x7) {
-            case 0x0: return  xf + yf;
-            case 0x1: return  xf;
-            case 0x2: return  xf - yf;
-            case 0x3: return -yf;
-            case 0x4: return -xf - yf;
-            case 0x5: return -xf;
-            case 0x6: return -xf + yf;
-            case 0x7: return  yf;
-            default:  return  T(0.0);
-        }
+    auto perlin_generator::perlin_d(T x, T y, T z) const -> noise_gradient<T> {
+        return db::perlin_d(m_permutation, x, y, z);
     }
 
     template<typename T>
-    static constexpr auto dot_grad(int hash, T xf, T yf, T zf) -> T {
-        // In 3D case, the gradient may be any of 12 direction vectors pointing to the edges
-        // of a unit-cube (rounded to 16 with duplications). The distance vector is the input
-        // offset (relative to the smallest bound).
-        switch (hash & 0xF) {
-            case 0x0: return  xf + yf;
-            case 0x1: return -xf + yf;
-            case 0x2: return  xf - yf;
-            case 0x3: return -xf - yf;
-            case 0x4: return  xf + zf;
-            case 0x5: return -xf + zf;
-            case 0x6: return  xf - zf;
-            case 0x7: return -xf - zf;
-            case 0x8: return  yf + zf;
-            case 0x9: return -yf + zf;
-            case 0xA: return  yf - zf;
-            case 0xB: return -yf - zf;
-            case 0xC: return  yf + xf;
-            case 0xD: return -yf + zf;
-            case 0xE: return  yf - xf;
-            case 0xF: return -yf - zf;
-            default:  return  T(0.0);
-        }
+    auto perlin_generator::fbm(T x, fractal<T> const& f) const -> T {
+        return db::fbm(m_permutation, x, f);
     }
 
     template<typename T>
-    constexpr auto perlin(T x) -> T {
-        // Left coordinate of the unit-line that contains the input.
-        int const xi0 = floor(x);
+    auto perlin_generator::fbm(T x, T y, fractal<T> const& f) const -> T {
+        return db::fbm(m_permutation, x, y, f);
+    }
 
-        // Input location in the unit-line.
-        T const xf0 = x - T(xi0);
-        T const xf1 = xf0 - T(1.0);
+    template<typename T>
+    auto perlin_generator::fbm(T x, T y, T z, fractal<T> const& f) const -> T {
+        return db::fbm(m_permutation, x, y, z, f);
+    }
 
-        // Wrap to range 0-255.
-        int const xi = xi0 & 0xFF;
+    template<typename T>
+    auto perlin_generator::ridged(T x, fractal<T> const& f) const -> T {
+        return db::ridged(m_permutation, x, f);
+    }
 
-        // Apply the fade function to the location.
-        T const u = fade(xf0);
+    template<typename T>
+    auto perlin_generator::ridged(T x, T y, fractal<T> const& f) const -> T {
+        return db::ridged(m_permutation, x, y, f);
+    }
 
-        // Generate hash values for each point of the unit-line.
-        int const h0 = p[xi + 0];
-        int const h1 = p[xi + 1];
+    template<typename T>
+    auto perlin_generator::ridged(T x, T y, T z, fractal<T> const& f) const -> T {
+        return db::ridged(m_permutation, x, y, z, f);
+    }
 
-        // Linearly interpolate between dot products of each gradient with its distance to the input location.
-        return lerp(dot_grad(h0, xf0), dot_grad(h1, xf1), u);
+    template<typename T>
+    auto perlin_generator::turbulence(T x, fractal<T> const& f) const -> T {
+        return db::turbulence(m_permutation, x, f);
     }
 
     template<typename T>
-    constexpr auto perlin(T x, T y) -> T {
-        // Top-left coordinates of the unit-square.
-        int const xi0 = floor(x);
-        int const yi0 = floor(y);
+    auto perlin_generator::turbulence(T x, T y, fractal<T> const& f) const -> T {
+        return db::turbulence(m_permutation, x, y, f);
+    }
 
-        // Input location in the unit-square.
-        T const xf0 = x - T(xi0);
-        T const yf0 = y - T(yi0);
-        T const xf1 = xf0 - T(1.0);
-        T const yf1 = yf0 - T(1.0);
+    template<typename T>
+    auto perlin_generator::turbulence(T x, T y, T z, fractal<T> const& f) const -> T {
+        return db::turbulence(m_permutation, x, y, z, f);
+    }
 
-        // Wrap to range 0-255.
-        int const xi = xi0 & 0xFF;
-        int const yi = yi0 & 0xFF;
+    template<typename T>
+    auto perlin_generator::fbm_periodic(T x, int px, fractal<T> const& f) const -> T {
+        return db::fbm_periodic(m_permutation, x, px, f);
+    }
 
-        // Apply the fade function to the location.
-        T const u = fade(xf0);
-        T const v = fade(yf0);
+    template<typename T>
+    auto perlin_generator::fbm_periodic(T x, T y, int px, int py, fractal<T> const& f) const -> T {
+        return db::fbm_periodic(m_permutation, x, y, px, py, f);
+    }
 
-        // Generate hash values for each point of the unit-square.
-        int const h00 = p[p[xi + 0] + yi + 0];
-        int const h01 = p[p[xi + 0] + yi + 1];
-        int const h10 = p[p[xi + 1] + yi + 0];
-        int const h11 = p[p[xi + 1] + yi + 1];
+    template<typename T>
+    auto perlin_generator::fbm_periodic(T x, T y, T z, int px, int py, int pz, fractal<T> const& f) const -> T {
+        return db::fbm_periodic(m_permutation, x, y, z, px, py, pz, f);
+    }
 
-        // Linearly interpolate between dot products of each gradient with its distance to the input location.
-        T const x1 = lerp(dot_grad(h00, xf0, yf0), dot_grad(h10, xf1, yf0), u);
-        T const x2 = lerp(dot_grad(h01, xf0, yf1), dot_grad(h11, xf1, yf1), u);
-        return lerp(x1, x2, v);
+    template<typename T>
+    auto perlin_generator::fbm_progressive(T x, fractal<T> const& f, T tolerance) const -> T {
+        return db::fbm_progressive(m_permutation, x, f, tolerance);
     }
 
     template<typename T>
-    constexpr auto perlin(T x, T y, T z) -> T {
-        // Top-left coordinates of the unit-cube.
-        int const xi0 = floor(x);
-        int const yi0 = floor(y);
-        int const zi0 = floor(z);
+    auto perlin_generator::fbm_progressive(T x, T y, fractal<T> const& f, T tolerance) const -> T {
+        return db::fbm_progressive(m_permutation, x, y, f, tolerance);
+    }
 
-        // Input location in the unit-cube.
-        T const xf0 = x - T(xi0);
-        T const yf0 = y - T(yi0);
-        T const zf0 = z - T(zi0);
-        T const xf1 = xf0 - T(1.0);
-        T const yf1 = yf0 - T(1.0);
-        T const zf1 = zf0 - T(1.0);
+    template<typename T>
+    auto perlin_generator::fbm_progressive(T x, T y, T z, fractal<T> const& f, T tolerance) const -> T {
+        return db::fbm_progressive(m_permutation, x, y, z, f, tolerance);
+    }
 
-        // Wrap to range 0-255.
-        int const xi = xi0 & 0xFF;
-        int const yi = yi0 & 0xFF;
-        int const zi = zi0 & 0xFF;
+    template<typename T>
+    auto perlin_generator::fbm_classify(T x, fractal<T> const& f, T const* thresholds, int count) const -> int {
+        return db::fbm_classify(m_permutation, x, f, thresholds, count);
+    }
 
-        // Apply the fade function to the location.
-        T const u = fade(xf0);
-        T const v = fade(yf0);
-        T const w = fade(zf0);
+    template<typename T>
+    auto perlin_generator::fbm_classify(T x, T y, fractal<T> const& f, T const* thresholds, int count) const -> int {
+        return db::fbm_classify(m_permutation, x, y, f, thresholds, count);
+    }
 
-        // Generate hash values for each point of the unit-cube.
-        int const h000 = p[p[p[xi + 0] + yi + 0] + zi + 0];
-        int const h001 = p[p[p[xi + 0] + yi + 0] + zi + 1];
-        int const h010 = p[p[p[xi + 0] + yi + 1] + zi + 0];
-        int const h011 = p[p[p[xi + 0] + yi + 1] + zi + 1];
-        int const h100 = p[p[p[xi + 1] + yi + 0] + zi + 0];
-        int const h101 = p[p[p[xi + 1] + yi + 0] + zi + 1];
-        int const h110 = p[p[p[xi + 1] + yi + 1] + zi + 0];
-        int const h111 = p[p[p[xi + 1] + yi + 1] + zi + 1];
+    template<typename T>
+    auto perlin_generator::fbm_classify(T x, T y, T z, fractal<T> const& f, T const* thresholds, int count) const -> int {
+        return db::fbm_classify(m_permutation, x, y, z, f, thresholds, count);
+    }
 
-        // Linearly interpolate between dot products of each gradient with its distance to the input location.
-        T const x11 = lerp(dot_grad(h000, xf0, yf0, zf0), dot_grad(h100, xf1, yf0, zf0), u);
-        T const x12 = lerp(dot_grad(h010, xf0, yf1, zf0), dot_grad(h110, xf1, yf1, zf0), u);
-        T const x21 = lerp(dot_grad(h001, xf0, yf0, zf1), dot_grad(h101, xf1, yf0, zf1), u);
-        T const x22 = lerp(dot_grad(h011, xf0, yf1, zf1), dot_grad(h111, xf1, yf1, zf1), u);
+    template<typename T>
+    auto perlin_generator::perlin_fill_2d(T* out, int width, int height, T x0, T y0, T step) const -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_fill_2d", 2, static_cast<long long>(width) * height);
+        fill_2d(m_permutation, out, width, width, height, x0, y0, step, T(1.0), false);
+    }
 
-        T const y1 = lerp(x11, x12, v);
-        T const y2 = lerp(x21, x22, v);
+    template<typename T>
+    auto perlin_generator::perlin_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step) const -> void {
+        DB_PERLIN_PROFILE_BATCH(T, "perlin_fill_3d", 3, static_cast<long long>(width) * height * depth);
+        fill_3d(m_permutation, out, width, height, depth, x0, y0, z0, step, T(1.0), false);
+    }
 
-        return lerp(y1, y2, w);
+    DB_PERLIN_INLINE auto perlin_generator::perlin_fill_2d_u8(std::uint8_t* out, int width, int height, double x0, double y0, double step) const -> void {
+        fill_2d_fixed(m_permutation, out, width, height, x0, y0, step);
+    }
+
+    DB_PERLIN_INLINE auto perlin_generator::perlin_fill_2d_u16(std::uint16_t* out, int width, int height, double x0, double y0, double step) const -> void {
+        fill_2d_fixed(m_permutation, out, width, height, x0, y0, step);
+    }
+
+    DB_PERLIN_INLINE auto perlin_generator::perlin_fill_3d_u8(std::uint8_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) const -> void {
+        fill_3d_fixed(m_permutation, out, width, height, depth, x0, y0, z0, step);
+    }
+
+    DB_PERLIN_INLINE auto perlin_generator::perlin_fill_3d_u16(std::uint16_t* out, int width, int height, int depth, double x0, double y0, double z0, double step) const -> void {
+        fill_3d_fixed(m_permutation, out, width, height, depth, x0, y0, z0, step);
+    }
+
+    template<typename T>
+    auto perlin_generator::fbm_fill_2d(T* out, int width, int height, T x0, T y0, T step, fractal<T> const& f) const -> void {
+        db::fbm_fill_2d(m_permutation, out, width, width, height, x0, y0, step, f);
+    }
+
+    template<typename T>
+    auto perlin_generator::fbm_fill_3d(T* out, int width, int height, int depth, T x0, T y0, T z0, T step, fractal<T> const& f) const -> void {
+        db::fbm_fill_3d(m_permutation, out, width, height, depth, x0, y0, z0, step, f);
+    }
+
+    template<typename T>
+    auto perlin_generator::perlin_n(T const* xs, T* out, std::size_t n) const -> void {
+        db::perlin_n(m_permutation, xs, out, n);
+    }
+
+    template<typename T>
+    auto perlin_generator::perlin_n(T const* xs, T const* ys, T* out, std::size_t n) const -> void {
+        db::perlin_n(m_permutation, xs, ys, out, n);
+    }
+
+    template<typename T>
+    auto perlin_generator::perlin_n(T const* xs, T const* ys, T const* zs, T* out, std::size_t n) const -> void {
+        db::perlin_n(m_permutation, xs, ys, zs, out, n);
     }
 }
 
+// In header-only mode the templates are instantiated implicitly wherever they are used.
+#ifndef DB_PERLIN_HEADER_ONLY
+
 template auto db::perlin<float>(float x) -> float;
 template auto db::perlin<float>(float x, float y) -> float;
 template auto db::perlin<float>(float x, float y, float z) -> float;
 
+template auto db::simplex<float>(float x) -> float;
+template auto db::simplex<float>(float x, float y) -> float;
+template auto db::simplex<float>(float x, float y, float z) -> float;
+template auto db::simplex<float>(float x, float y, float z, float w) -> float;
+
+template auto db::perlin_periodic<float>(float x, int px) -> float;
+template auto db::perlin_periodic<float>(float x, float y, int px, int py) -> float;
+template auto db::perlin_periodic<float>(float x, float y, float z, int px, int py, int pz) -> float;
+
+template auto db::perlin_d<float>(float x) -> noise_gradient<float>;
+template auto db::perlin_d<float>(float x, float y) -> noise_gradient<float>;
+template auto db::perlin_d<float>(float x, float y, float z) -> noise_gradient<float>;
+
 template auto db::perlin<double>(double x) -> double;
 template auto db::perlin<double>(double x, double y) -> double;
 template auto db::perlin<double>(double x, double y, double z) -> double;
 
+template auto db::simplex<double>(double x) -> double;
+template auto db::simplex<double>(double x, double y) -> double;
+template auto db::simplex<double>(double x, double y, double z) -> double;
+template auto db::simplex<double>(double x, double y, double z, double w) -> double;
+
+template auto db::perlin_periodic<double>(double x, int px) -> double;
+template auto db::perlin_periodic<double>(double x, double y, int px, int py) -> double;
+template auto db::perlin_periodic<double>(double x, double y, double z, int px, int py, int pz) -> double;
+
+template auto db::perlin_d<double>(double x) -> noise_gradient<double>;
+template auto db::perlin_d<double>(double x, double y) -> noise_gradient<double>;
+template auto db::perlin_d<double>(double x, double y, double z) -> noise_gradient<double>;
+
+template auto db::perlin_fill_2d<float>(float* out, int width, int height, float x0, float y0, float step) -> void;
+template auto db::perlin_fill_3d<float>(float* out, int width, int height, int depth, float x0, float y0, float z0, float step) -> void;
+
+template auto db::perlin_fill_2d<double>(double* out, int width, int height, double x0, double y0, double step) -> void;
+template auto db::perlin_fill_3d<double>(double* out, int width, int height, int depth, double x0, double y0, double z0, double step) -> void;
+
+template auto db::fbm<float>(float x, fractal<float> const& f) -> float;
+template auto db::fbm<float>(float x, float y, fractal<float> const& f) -> float;
+template auto db::fbm<float>(float x, float y, float z, fractal<float> const& f) -> float;
+template auto db::fbm<float>(float x, int octaves, float lacunarity, float gain) -> float;
+template auto db::fbm<float>(float x, float y, int octaves, float lacunarity, float gain) -> float;
+template auto db::fbm<float>(float x, float y, float z, int octaves, float lacunarity, float gain) -> float;
+
+template auto db::ridged<float>(float x, fractal<float> const& f) -> float;
+template auto db::ridged<float>(float x, float y, fractal<float> const& f) -> float;
+template auto db::ridged<float>(float x, float y, float z, fractal<float> const& f) -> float;
+template auto db::ridged<float>(float x, int octaves, float lacunarity, float gain) -> float;
+template auto db::ridged<float>(float x, float y, int octaves, float lacunarity, float gain) -> float;
+template auto db::ridged<float>(float x, float y, float z, int octaves, float lacunarity, float gain) -> float;
+
+template auto db::turbulence<float>(float x, fractal<float> const& f) -> float;
+template auto db::turbulence<float>(float x, float y, fractal<float> const& f) -> float;
+template auto db::turbulence<float>(float x, float y, float z, fractal<float> const& f) -> float;
+template auto db::turbulence<float>(float x, int octaves, float lacunarity, float gain) -> float;
+template auto db::turbulence<float>(float x, float y, int octaves, float lacunarity, float gain) -> float;
+template auto db::turbulence<float>(float x, float y, float z, int octaves, float lacunarity, float gain) -> float;
+
+template auto db::fbm_periodic<float>(float x, int px, fractal<float> const& f) -> float;
+template auto db::fbm_periodic<float>(float x, float y, int px, int py, fractal<float> const& f) -> float;
+template auto db::fbm_periodic<float>(float x, float y, float z, int px, int py, int pz, fractal<float> const& f) -> float;
+
+template auto db::fbm_progressive<float>(float x, fractal<float> const& f, float tolerance) -> float;
+template auto db::fbm_progressive<float>(float x, float y, fractal<float> const& f, float tolerance) -> float;
+template auto db::fbm_progressive<float>(float x, float y, float z, fractal<float> const& f, float tolerance) -> float;
+
+template auto db::fbm_classify<float>(float x, fractal<float> const& f, float const* thresholds, int count) -> int;
+template auto db::fbm_classify<float>(float x, float y, fractal<float> const& f, float const* thresholds, int count) -> int;
+template auto db::fbm_classify<float>(float x, float y, float z, fractal<float> const& f, float const* thresholds, int count) -> int;
+
+template auto db::fbm_fill_2d<float>(float* out, int width, int height, float x0, float y0, float step, fractal<float> const& f) -> void;
+template auto db::fbm_fill_3d<float>(float* out, int width, int height, int depth, float x0, float y0, float z0, float step, fractal<float> const& f) -> void;
+
+template auto db::fbm<double>(double x, fractal<double> const& f) -> double;
+template auto db::fbm<double>(double x, double y, fractal<double> const& f) -> double;
+template auto db::fbm<double>(double x, double y, double z, fractal<double> const& f) -> double;
+template auto db::fbm<double>(double x, int octaves, double lacunarity, double gain) -> double;
+template auto db::fbm<double>(double x, double y, int octaves, double lacunarity, double gain) -> double;
+template auto db::fbm<double>(double x, double y, double z, int octaves, double lacunarity, double gain) -> double;
+
+template auto db::ridged<double>(double x, fractal<double> const& f) -> double;
+template auto db::ridged<double>(double x, double y, fractal<double> const& f) -> double;
+template auto db::ridged<double>(double x, double y, double z, fractal<double> const& f) -> double;
+template auto db::ridged<double>(double x, int octaves, double lacunarity, double gain) -> double;
+template auto db::ridged<double>(double x, double y, int octaves, double lacunarity, double gain) -> double;
+template auto db::ridged<double>(double x, double y, double z, int octaves, double lacunarity, double gain) -> double;
+
+template auto db::turbulence<double>(double x, fractal<double> const& f) -> double;
+template auto db::turbulence<double>(double x, double y, fractal<double> const& f) -> double;
+template auto db::turbulence<double>(double x, double y, double z, fractal<double> const& f) -> double;
+template auto db::turbulence<double>(double x, int octaves, double lacunarity, double gain) -> double;
+template auto db::turbulence<double>(double x, double y, int octaves, double lacunarity, double gain) -> double;
+template auto db::turbulence<double>(double x, double y, double z, int octaves, double lacunarity, double gain) -> double;
+
+template auto db::fbm_periodic<double>(double x, int px, fractal<double> const& f) -> double;
+template auto db::fbm_periodic<double>(double x, double y, int px, int py, fractal<double> const& f) -> double;
+template auto db::fbm_periodic<double>(double x, double y, double z, int px, int py, int pz, fractal<double> const& f) -> double;
+
+template auto db::fbm_progressive<double>(double x, fractal<double> const& f, double tolerance) -> double;
+template auto db::fbm_progressive<double>(double x, double y, fractal<double> const& f, double tolerance) -> double;
+template auto db::fbm_progressive<double>(double x, double y, double z, fractal<double> const& f, double tolerance) -> double;
+
+template auto db::fbm_classify<double>(double x, fractal<double> const& f, double const* thresholds, int count) -> int;
+template auto db::fbm_classify<double>(double x, double y, fractal<double> const& f, double const* thresholds, int count) -> int;
+template auto db::fbm_classify<double>(double x, double y, double z, fractal<double> const& f, double const* thresholds, int count) -> int;
+
+template auto db::fbm_fill_2d<double>(double* out, int width, int height, double x0, double y0, double step, fractal<double> const& f) -> void;
+template auto db::fbm_fill_3d<double>(double* out, int width, int height, int depth, double x0, double y0, double z0, double step, fractal<double> const& f) -> void;
+
+template auto db::perlin_n<float>(float const* xs, float* out, std::size_t n) -> void;
+template auto db::perlin_n<float>(float const* xs, float const* ys, float* out, std::size_t n) -> void;
+template auto db::perlin_n<float>(float const* xs, float const* ys, float const* zs, float* out, std::size_t n) -> void;
+
+template auto db::perlin_n<double>(double const* xs, double* out, std::size_t n) -> void;
+template auto db::perlin_n<double>(double const* xs, double const* ys, double* out, std::size_t n) -> void;
+template auto db::perlin_n<double>(double const* xs, double const* ys, double const* zs, double* out, std::size_t n) -> void;
+
+template auto db::perlin_generator::perlin<float>(float x) const -> float;
+template auto db::perlin_generator::perlin<float>(float x, float y) const -> float;
+template auto db::perlin_generator::perlin<float>(float x, float y, float z) const -> float;
+
+template auto db::perlin_generator::simplex<float>(float x) const -> float;
+template auto db::perlin_generator::simplex<float>(float x, float y) const -> float;
+template auto db::perlin_generator::simplex<float>(float x, float y, float z) const -> float;
+template auto db::perlin_generator::simplex<float>(float x, float y, float z, float w) const -> float;
+
+template auto db::perlin_generator::perlin_periodic<float>(float x, int px) const -> float;
+template auto db::perlin_generator::perlin_periodic<float>(float x, float y, int px, int py) const -> float;
+template auto db::perlin_generator::perlin_periodic<float>(float x, float y, float z, int px, int py, int pz) const -> float;
+
+template auto db::perlin_generator::perlin_d<float>(float x) const -> noise_gradient<float>;
+template auto db::perlin_generator::perlin_d<float>(float x, float y) const -> noise_gradient<float>;
+template auto db::perlin_generator::perlin_d<float>(float x, float y, float z) const -> noise_gradient<float>;
+
+template auto db::perlin_generator::fbm<float>(float x, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::fbm<float>(float x, float y, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::fbm<float>(float x, float y, float z, fractal<float> const& f) const -> float;
+
+template auto db::perlin_generator::ridged<float>(float x, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::ridged<float>(float x, float y, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::ridged<float>(float x, float y, float z, fractal<float> const& f) const -> float;
+
+template auto db::perlin_generator::turbulence<float>(float x, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::turbulence<float>(float x, float y, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::turbulence<float>(float x, float y, float z, fractal<float> const& f) const -> float;
+
+template auto db::perlin_generator::fbm_periodic<float>(float x, int px, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::fbm_periodic<float>(float x, float y, int px, int py, fractal<float> const& f) const -> float;
+template auto db::perlin_generator::fbm_periodic<float>(float x, float y, float z, int px, int py, int pz, fractal<float> const& f) const -> float;
+
+template auto db::perlin_generator::fbm_progressive<float>(float x, fractal<float> const& f, float tolerance) const -> float;
+template auto db::perlin_generator::fbm_progressive<float>(float x, float y, fractal<float> const& f, float tolerance) const -> float;
+template auto db::perlin_generator::fbm_progressive<float>(float x, float y, float z, fractal<float> const& f, float tolerance) const -> float;
+
+template auto db::perlin_generator::fbm_classify<float>(float x, fractal<float> const& f, float const* thresholds, int count) const -> int;
+template auto db::perlin_generator::fbm_classify<float>(float x, float y, fractal<float> const& f, float const* thresholds, int count) const -> int;
+template auto db::perlin_generator::fbm_classify<float>(float x, float y, float z, fractal<float> const& f, float const* thresholds, int count) const -> int;
+
+template auto db::perlin_generator::perlin_fill_2d<float>(float* out, int width, int height, float x0, float y0, float step) const -> void;
+template auto db::perlin_generator::perlin_fill_3d<float>(float* out, int width, int height, int depth, float x0, float y0, float z0, float step) const -> void;
+template auto db::perlin_generator::fbm_fill_2d<float>(float* out, int width, int height, float x0, float y0, float step, fractal<float> const& f) const -> void;
+template auto db::perlin_generator::fbm_fill_3d<float>(float* out, int width, int height, int depth, float x0, float y0, float z0, float step, fractal<float> const& f) const -> void;
+
+template auto db::perlin_generator::perlin_n<float>(float const* xs, float* out, std::size_t n) const -> void;
+template auto db::perlin_generator::perlin_n<float>(float const* xs, float const* ys, float* out, std::size_t n) const -> void;
+template auto db::perlin_generator::perlin_n<float>(float const* xs, float const* ys, float const* zs, float* out, std::size_t n) const -> void;
+
+template auto db::perlin_generator::perlin<double>(double x) const -> double;
+template auto db::perlin_generator::perlin<double>(double x, double y) const -> double;
+template auto db::perlin_generator::perlin<double>(double x, double y, double z) const -> double;
+
+template auto db::perlin_generator::simplex<double>(double x) const -> double;
+template auto db::perlin_generator::simplex<double>(double x, double y) const -> double;
+template auto db::perlin_generator::simplex<double>(double x, double y, double z) const -> double;
+template auto db::perlin_generator::simplex<double>(double x, double y, double z, double w) const -> double;
+
+template auto db::perlin_generator::perlin_periodic<double>(double x, int px) const -> double;
+template auto db::perlin_generator::perlin_periodic<double>(double x, double y, int px, int py) const -> double;
+template auto db::perlin_generator::perlin_periodic<double>(double x, double y, double z, int px, int py, int pz) const -> double;
+
+template auto db::perlin_generator::perlin_d<double>(double x) const -> noise_gradient<double>;
+template auto db::perlin_generator::perlin_d<double>(double x, double y) const -> noise_gradient<double>;
+template auto db::perlin_generator::perlin_d<double>(double x, double y, double z) const -> noise_gradient<double>;
+
+template auto db::perlin_generator::fbm<double>(double x, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::fbm<double>(double x, double y, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::fbm<double>(double x, double y, double z, fractal<double> const& f) const -> double;
+
+template auto db::perlin_generator::ridged<double>(double x, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::ridged<double>(double x, double y, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::ridged<double>(double x, double y, double z, fractal<double> const& f) const -> double;
+
+template auto db::perlin_generator::turbulence<double>(double x, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::turbulence<double>(double x, double y, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::turbulence<double>(double x, double y, double z, fractal<double> const& f) const -> double;
+
+template auto db::perlin_generator::fbm_periodic<double>(double x, int px, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::fbm_periodic<double>(double x, double y, int px, int py, fractal<double> const& f) const -> double;
+template auto db::perlin_generator::fbm_periodic<double>(double x, double y, double z, int px, int py, int pz, fractal<double> const& f) const -> double;
+
+template auto db::perlin_generator::fbm_progressive<double>(double x, fractal<double> const& f, double tolerance) const -> double;
+template auto db::perlin_generator::fbm_progressive<double>(double x, double y, fractal<double> const& f, double tolerance) const -> double;
+template auto db::perlin_generator::fbm_progressive<double>(double x, double y, double z, fractal<double> const& f, double tolerance) const -> double;
+
+template auto db::perlin_generator::fbm_classify<double>(double x, fractal<double> const& f, double const* thresholds, int count) const -> int;
+template auto db::perlin_generator::fbm_classify<double>(double x, double y, fractal<double> const& f, double const* thresholds, int count) const -> int;
+template auto db::perlin_generator::fbm_classify<double>(double x, double y, double z, fractal<double> const& f, double const* thresholds, int count) const -> int;
+
+template auto db::perlin_generator::perlin_fill_2d<double>(double* out, int width, int height, double x0, double y0, double step) const -> void;
+template auto db::perlin_generator::perlin_fill_3d<double>(double* out, int width, int height, int depth, double x0, double y0, double z0, double step) const -> void;
+template auto db::perlin_generator::fbm_fill_2d<double>(double* out, int width, int height, double x0, double y0, double step, fractal<double> const& f) const -> void;
+template auto db::perlin_generator::fbm_fill_3d<double>(double* out, int width, int height, int depth, double x0, double y0, double z0, double step, fractal<double> const& f) const -> void;
+
+template auto db::perlin_generator::perlin_n<double>(double const* xs, double* out, std::size_t n) const -> void;
+template auto db::perlin_generator::perlin_n<double>(double const* xs, double const* ys, double* out, std::size_t n) const -> void;
+template auto db::perlin_generator::perlin_n<double>(double const* xs, double const* ys, double const* zs, double* out, std::size_t n) const -> void;
+
+#endif // DB_PERLIN_HEADER_ONLY
+
 #endif // DB_PERLIN_IMPL
 
 #endif // DB_PERLIN_HPP
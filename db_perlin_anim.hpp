@@ -0,0 +1,302 @@
+/*
+ * db-perlin - see license at the bottom, no warranty implied, use at your own risk;
+ *     made by daniilsjb (https://github.com/daniilsjb/perlin-noise)
+ *
+ * The following is an animated field of noise: a fixed grid of samples in the xy-plane, whose
+ * third coordinate (usually time) changes from frame to frame. This is a common way to animate
+ * effects such as water and clouds, where each frame is a slice of the 3D noise.
+ *
+ * Evaluating the 3D noise from scratch for every frame repeats a lot of work, as almost all of
+ * it depends on the x and y coordinates alone. Within a unit-cube, the dot products of the
+ * gradients with the distance vectors are linear in the z-coordinate, and so are their
+ * interpolations along the x and y axes. The field therefore keeps four coefficients per sample
+ * and octave, which reduce a frame to a single interpolation per sample:
+ *
+ *   noise = lerp(a0 + b0 * zf, a1 + b1 * (zf - 1), fade(zf))
+ *
+ * The coefficients only change once the z-coordinate crosses into the next unit-cube, and are
+ * then recomputed from the hashes of the xy-plane, which are cached as well. Everything is
+ * rebuilt when the view changes (e.g., when the field is panned or zoomed).
+ *
+ * The samples are equal to those of `fbm(x, y, z, f)` up to rounding errors, as the terms of the
+ * noise are summed up in a different order.
+ *
+ * Usage:
+ *
+ * This header follows the same conventions as db_perlin.hpp, and must be included after it:
+ *
+ * ```cpp
+ * #define DB_PERLIN_IMPL
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_anim.hpp"
+ * ```
+ *
+ * Create the field for the size of the image, point it at the region to show, and evaluate it
+ * for every frame:
+ *
+ * ```cpp
+ * db::animated_field<float> clouds { width, height, db::fractal<float> { 4 } };
+ * clouds.set_view(x0, y0, 1.0f / 64.0f);
+ *
+ * for (float time = 0.0f; running; time += 0.01f) {
+ *     clouds.evaluate(time, pixels.data());
+ * }
+ * ```
+ *
+ * A field keeps about 4 bytes plus four values of type `T` per sample for every octave.
+ */
+
+#ifndef DB_PERLIN_ANIM_HPP
+#define DB_PERLIN_ANIM_HPP
+
+#ifndef DB_PERLIN_HPP
+#error "Please, include db_perlin.hpp before db_perlin_anim.hpp"
+#endif
+
+#include <vector>
+
+namespace db {
+    template<typename T>
+    class animated_field {
+    public:
+        // Creates a field of `width * height` samples. The generator (if any) must outlive the field.
+        animated_field(int width, int height, fractal<T> const& f = fractal<T> { 1 }, perlin_generator const* generator = nullptr);
+
+        auto width() const -> int;
+        auto height() const -> int;
+
+        // Places sample (i, j) at (x0 + i * step, y0 + j * step), rebuilding all cached state.
+        auto set_view(T x0, T y0, T step) -> void;
+
+        // Writes the samples of the field at the given z-coordinate into `out` (row-major).
+        auto evaluate(T z, T* out) -> void;
+
+    private:
+        struct octave {
+            std::vector<T> xf;                  // Per column: the location in the unit-square...
+            std::vector<T> u;                   // ...and its faded value.
+            std::vector<T> yf;                  // Per row: the same along the y-axis.
+            std::vector<T> v;
+            std::vector<unsigned char> hashes;  // Per sample: the hashes of the four corners of the unit-square.
+            std::vector<T> a0, b0, a1, b1;      // Per sample: the coefficients within the current unit-cube.
+            int zi = -1;                        // The unit-cube the coefficients belong to (-1 for none).
+        };
+
+        auto update(octave& o, int zi) -> void;
+
+        int m_width;
+        int m_height;
+        fractal<T> m_fractal;
+        permutation const* m_permutation;
+        std::vector<octave> m_octaves;
+    };
+}
+
+#ifdef DB_PERLIN_IMPL
+
+namespace db {
+    template<typename T>
+    animated_field<T>::animated_field(int width, int height, fractal<T> const& f, perlin_generator const* generator)
+        : m_width { (width < 0) ? 0 : width }
+        , m_height { (height < 0) ? 0 : height }
+        , m_fractal { f }
+        , m_permutation { generator ? &generator->table() : &default_permutation }
+        , m_octaves(static_cast<std::size_t>(m_fractal.octaves)) {
+        set_view(T(0.0), T(0.0), T(1.0));
+    }
+
+    template<typename T>
+    auto animated_field<T>::width() const -> int {
+        return m_width;
+    }
+
+    template<typename T>
+    auto animated_field<T>::height() const -> int {
+        return m_height;
+    }
+
+    template<typename T>
+    auto animated_field<T>::set_view(T x0, T y0, T step) -> void {
+        permutation const& perm = *m_permutation;
+        auto const width = static_cast<std::size_t>(m_width);
+        auto const height = static_cast<std::size_t>(m_height);
+        auto const count = width * height;
+
+        std::vector<int> px(width * 2);
+        std::vector<int> py(height);
+
+        for (int k = 0; k < m_fractal.octaves; ++k) {
+            T const frequency = m_fractal.frequency[k];
+            octave& o = m_octaves[static_cast<std::size_t>(k)];
+
+            o.xf.resize(width);
+            o.u.resize(width);
+            o.yf.resize(height);
+            o.v.resize(height);
+            o.hashes.resize(count * 4);
+            o.a0.resize(count);
+            o.b0.resize(count);
+            o.a1.resize(count);
+            o.b1.resize(count);
+            o.zi = -1;
+
+            // The coordinates are scaled in the same way as in `fbm`.
+            for (std::size_t i = 0; i < width; ++i) {
+                T const x = (x0 + T(i) * step) * frequency;
+                int const xi0 = floor(x);
+                o.xf[i] = x - T(xi0);
+                o.u[i] = fade(o.xf[i]);
+                px[i * 2 + 0] = perm.p[(xi0 & 0xFF) + 0];
+                px[i * 2 + 1] = perm.p[(xi0 & 0xFF) + 1];
+            }
+
+            for (std::size_t j = 0; j < height; ++j) {
+                T const y = (y0 + T(j) * step) * frequency;
+                int const yi0 = floor(y);
+                o.yf[j] = y - T(yi0);
+                o.v[j] = fade(o.yf[j]);
+                py[j] = yi0 & 0xFF;
+            }
+
+            for (std::size_t j = 0; j < height; ++j) {
+                unsigned char* const row = o.hashes.data() + j * width * 4;
+                for (std::size_t i = 0; i < width; ++i) {
+                    int const a = px[i * 2 + 0] + py[j];
+                    int const b = px[i * 2 + 1] + py[j];
+                    row[i * 4 + 0] = static_cast<unsigned char>(perm.p[a + 0]);
+                    row[i * 4 + 1] = static_cast<unsigned char>(perm.p[a + 1]);
+                    row[i * 4 + 2] = static_cast<unsigned char>(perm.p[b + 0]);
+                    row[i * 4 + 3] = static_cast<unsigned char>(perm.p[b + 1]);
+                }
+            }
+        }
+    }
+
+    // Computes the coefficients of every sample of an octave within the given unit-cube. The dot
+    // product with the gradient g of a corner is (g.x * xf + g.y * yf) + g.z * zf, so the first
+    // part goes into the constant term and g.z into the slope.
+    template<typename T>
+    auto animated_field<T>::update(octave& o, int zi) -> void {
+        permutation const& perm = *m_permutation;
+        auto const width = static_cast<std::size_t>(m_width);
+        auto const height = static_cast<std::size_t>(m_height);
+
+        for (std::size_t j = 0; j < height; ++j) {
+            T const yf0 = o.yf[j];
+            T const yf1 = yf0 - T(1.0);
+            T const v = o.v[j];
+
+            for (std::size_t i = 0; i < width; ++i) {
+                std::size_t const s = j * width + i;
+                unsigned char const* const h = o.hashes.data() + s * 4;
+
+                T const xf0 = o.xf[i];
+                T const xf1 = xf0 - T(1.0);
+                T const u = o.u[i];
+
+                // Corners are named by their offsets along the x, y, and z axes.
+                signed char const* const g000 = grad3[perm.p[h[0] + zi + 0] & 0xF];
+                signed char const* const g001 = grad3[perm.p[h[0] + zi + 1] & 0xF];
+                signed char const* const g010 = grad3[perm.p[h[1] + zi + 0] & 0xF];
+                signed char const* const g011 = grad3[perm.p[h[1] + zi + 1] & 0xF];
+                signed char const* const g100 = grad3[perm.p[h[2] + zi + 0] & 0xF];
+                signed char const* const g101 = grad3[perm.p[h[2] + zi + 1] & 0xF];
+                signed char const* const g110 = grad3[perm.p[h[3] + zi + 0] & 0xF];
+                signed char const* const g111 = grad3[perm.p[h[3] + zi + 1] & 0xF];
+
+                T const c000 = T(g000[0]) * xf0 + T(g000[1]) * yf0;
+                T const c001 = T(g001[0]) * xf0 + T(g001[1]) * yf0;
+                T const c010 = T(g010[0]) * xf0 + T(g010[1]) * yf1;
+                T const c011 = T(g011[0]) * xf0 + T(g011[1]) * yf1;
+                T const c100 = T(g100[0]) * xf1 + T(g100[1]) * yf0;
+                T const c101 = T(g101[0]) * xf1 + T(g101[1]) * yf0;
+                T const c110 = T(g110[0]) * xf1 + T(g110[1]) * yf1;
+                T const c111 = T(g111[0]) * xf1 + T(g111[1]) * yf1;
+
+                o.a0[s] = lerp(lerp(c000, c100, u), lerp(c010, c110, u), v);
+                o.a1[s] = lerp(lerp(c001, c101, u), lerp(c011, c111, u), v);
+                o.b0[s] = lerp(lerp(T(g000[2]), T(g100[2]), u), lerp(T(g010[2]), T(g110[2]), u), v);
+                o.b1[s] = lerp(lerp(T(g001[2]), T(g101[2]), u), lerp(T(g011[2]), T(g111[2]), u), v);
+            }
+        }
+
+        o.zi = zi;
+    }
+
+    template<typename T>
+    auto animated_field<T>::evaluate(T z, T* out) -> void {
+        auto const count = static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
+        DB_PERLIN_PROFILE_BATCH(T, "animated_field::evaluate", 3, count * static_cast<std::size_t>(m_fractal.octaves));
+
+        for (int k = 0; k < m_fractal.octaves; ++k) {
+            octave& o = m_octaves[static_cast<std::size_t>(k)];
+
+            T const zk = z * m_fractal.frequency[k];
+            int const zi0 = floor(zk);
+            T const zf0 = zk - T(zi0);
+            T const zf1 = zf0 - T(1.0);
+            T const w = fade(zf0);
+
+            int const zi = zi0 & 0xFF;
+            if (o.zi != zi) {
+                update(o, zi);
+            }
+
+            // Only the interpolation along the z-axis is left to do for each sample.
+            T const amplitude = m_fractal.amplitude[k];
+            T const* const a0 = o.a0.data();
+            T const* const b0 = o.b0.data();
+            T const* const a1 = o.a1.data();
+            T const* const b1 = o.b1.data();
+
+            if (k == 0) {
+                for (std::size_t s = 0; s < count; ++s) {
+                    out[s] = amplitude * lerp(a0[s] + b0[s] * zf0, a1[s] + b1[s] * zf1, w);
+                }
+            } else {
+                for (std::size_t s = 0; s < count; ++s) {
+                    out[s] += amplitude * lerp(a0[s] + b0[s] * zf0, a1[s] + b1[s] * zf1, w);
+                }
+            }
+        }
+
+        for (std::size_t s = 0; s < count; ++s) {
+            out[s] /= m_fractal.total_amplitude;
+        }
+    }
+}
+
+#ifndef DB_PERLIN_HEADER_ONLY
+
+template class db::animated_field<float>;
+template class db::animated_field<double>;
+
+#endif // DB_PERLIN_HEADER_ONLY
+
+#endif // DB_PERLIN_IMPL
+
+#endif // DB_PERLIN_ANIM_HPP
+
+/*
+MIT License
+
+Copyright (c) 2020-2025 Daniils Buts
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
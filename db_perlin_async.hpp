@@ -0,0 +1,460 @@
+/*
+ * db-perlin - see license at the bottom, no warranty implied, use at your own risk;
+ *     made by daniilsjb (https://github.com/daniilsjb/perlin-noise)
+ *
+ * The following is an asynchronous generator of chunks of noise, meant for worlds that are
+ * generated around a moving camera. Chunks are requested with a priority and generated on a pool
+ * of background threads, so the thread that requests them never waits. Each chunk is delivered
+ * through a future or a callback once all of its samples are ready.
+ *
+ * A chunk is generated in pieces, which are the tiles of `noise_engine` and small enough to stay
+ * in the L1 cache while all octaves are summed up. The workers always take the next piece of the
+ * most important chunk, so a chunk requested with a higher priority overtakes the ones that are
+ * already in progress, and several workers may share a large chunk. Chunks of equal priority are
+ * generated in the order in which they were requested.
+ *
+ * A chunk may be cancelled at any time (e.g., once the camera has moved away from it). The pieces
+ * that are being generated at that moment are finished, but no further pieces are started, and
+ * the chunk is delivered as cancelled without its samples. The priority of a chunk may be changed
+ * as well, which takes effect from its next piece.
+ *
+ * The pieces have the same origins as the tiles of `noise_engine::generate`, so the samples of a
+ * chunk are identical to those generated by the engine for the same region.
+ *
+ * Usage:
+ *
+ * This header follows the same conventions as db_perlin.hpp, and must be included after it and
+ * after db_perlin_engine.hpp. The implementation is compiled in the source file which defines
+ * `DB_PERLIN_IMPL`:
+ *
+ * ```cpp
+ * #define DB_PERLIN_IMPL
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_engine.hpp"
+ * #include "db_perlin_async.hpp"
+ * ```
+ *
+ * Chunks are described by the same regions as in `noise_engine`. Keep the ticket returned by
+ * `submit` to follow or control the chunk:
+ *
+ * ```cpp
+ * db::chunk_generator<float> chunks {};
+ *
+ * auto ticket = chunks.submit(region, priority);
+ * // ...
+ * if (ticket.ready()) {
+ *     db::chunk<float> chunk = ticket.get();
+ * }
+ *
+ * // Or, with a callback which is called from one of the worker threads:
+ * auto other = chunks.submit(region, priority, [](db::chunk<float>& chunk) {
+ *     upload(chunk.region, std::move(chunk.samples));
+ * });
+ * other.set_priority(priority + 1);
+ * other.cancel();
+ * ```
+ *
+ * Destroying the generator cancels all chunks that have not been delivered yet. Tickets may
+ * outlive the generator, and may be used from any thread.
+ */
+
+#ifndef DB_PERLIN_ASYNC_HPP
+#define DB_PERLIN_ASYNC_HPP
+
+#ifndef DB_PERLIN_HPP
+#error "Please, include db_perlin.hpp before db_perlin_async.hpp"
+#endif
+
+#ifndef DB_PERLIN_ENGINE_HPP
+#error "Please, include db_perlin_engine.hpp before db_perlin_async.hpp"
+#endif
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace db {
+    template<typename T>
+    struct chunk {
+        noise_region<T> region;
+        std::vector<T> samples; // Row-major, `region.width * region.height` samples (empty if cancelled).
+        bool cancelled;
+    };
+
+    template<typename T>
+    class chunk_generator {
+        struct state;
+        struct job;
+
+    public:
+        // Called with the chunk once it is complete or cancelled. The chunk may be moved from.
+        using callback = std::function<void(chunk<T>&)>;
+
+        class ticket {
+        public:
+            ticket() = default;
+
+            // Stops the generation of the chunk. Returns false if the chunk has already been
+            // delivered (or cancelled before), in which case nothing changes.
+            auto cancel() -> bool;
+
+            // Changes the priority of the chunk for the pieces that have not been started yet.
+            auto set_priority(int priority) -> void;
+
+            // Whether the chunk has been delivered (completed or cancelled).
+            auto ready() const -> bool;
+
+            // Waits for the chunk and returns it. May only be called once, and only for chunks
+            // submitted without a callback.
+            auto get() -> chunk<T>;
+
+        private:
+            friend class chunk_generator;
+            std::shared_ptr<state> m_state;
+            std::shared_ptr<job> m_job;
+            std::future<chunk<T>> m_future;
+        };
+
+        // Creates a generator with the given number of background threads. Zero picks the number
+        // of hardware threads available on the machine.
+        explicit chunk_generator(unsigned threads = 0);
+        ~chunk_generator();
+
+        chunk_generator(chunk_generator const&) = delete;
+        auto operator=(chunk_generator const&) -> chunk_generator& = delete;
+
+        auto thread_count() const -> unsigned;
+
+        // Requests a chunk of fractal noise, as described by `db::fbm`. Chunks with a higher
+        // priority are generated first. The generator of the region (if any) must outlive the chunk.
+        auto submit(noise_region<T> const& region, int priority = 0) -> ticket;
+
+        // Same as above, but the chunk is passed to `done` rather than to the ticket. The callback
+        // is called from a worker thread, or from the thread that cancels a chunk which has no
+        // pieces in progress, and must not throw.
+        auto submit(noise_region<T> const& region, int priority, callback done) -> ticket;
+
+        // Cancels every chunk that has not been delivered yet.
+        auto cancel_all() -> void;
+
+    private:
+        std::shared_ptr<state> m_state;
+        std::vector<std::thread> m_threads;
+    };
+}
+
+#ifdef DB_PERLIN_IMPL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace db {
+    template<typename T>
+    struct chunk_generator<T>::job {
+        noise_region<T> region;
+        fractal<T> f;
+        permutation const* perm;
+        std::vector<T> samples;
+        int columns;                  // The number of pieces along the x-axis.
+        int pieces;                   // The total number of pieces.
+
+        // Guarded by the mutex of the state.
+        int priority;
+        std::uint64_t sequence = 0;   // The order of submission, which breaks ties between priorities.
+        int next = 0;                 // The next piece to start.
+        int unfinished = 0;           // The pieces that have not been finished or dropped yet.
+        bool queued = false;
+        bool cancelled = false;
+
+        std::atomic<bool> delivered { false };
+        std::promise<chunk<T>> promise;
+        callback done;
+
+        job(noise_region<T> const& region_, int priority_)
+            : region { region_ }
+            , f { region_.octaves, region_.lacunarity, region_.gain }
+            , perm { region_.generator ? &region_.generator->table() : &default_permutation }
+            , columns { (region_.width + engine_tile_size - 1) / engine_tile_size }
+            , pieces { columns * ((region_.height + engine_tile_size - 1) / engine_tile_size) }
+            , priority { priority_ } {}
+    };
+
+    template<typename T>
+    struct chunk_generator<T>::state {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::vector<std::shared_ptr<job>> queue; // The chunks that have pieces left to start.
+        std::uint64_t sequence = 0;
+        unsigned count = 0;
+        bool stopping = false;
+
+        // The queue is expected to hold at most a few hundred chunks, and every piece takes far
+        // longer to generate than a scan over them, so a linear search keeps the priorities
+        // trivially adjustable without the bookkeeping of a heap.
+        auto best() const -> std::size_t {
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < queue.size(); ++i) {
+                job const& a = *queue[i];
+                job const& b = *queue[best];
+                if (a.priority > b.priority || (a.priority == b.priority && a.sequence < b.sequence)) {
+                    best = i;
+                }
+            }
+            return best;
+        }
+
+        auto dequeue(job& j) -> void {
+            for (std::size_t i = 0; i < queue.size(); ++i) {
+                if (queue[i].get() == &j) {
+                    queue[i] = std::move(queue.back());
+                    queue.pop_back();
+                    break;
+                }
+            }
+            j.queued = false;
+        }
+
+        static auto deliver(job& j, bool cancelled) -> void {
+            if (j.delivered.exchange(true, std::memory_order_acq_rel)) {
+                return;
+            }
+
+            chunk<T> result { j.region, {}, cancelled };
+            if (!cancelled) {
+                result.samples = std::move(j.samples);
+            }
+            std::vector<T> {}.swap(j.samples);
+
+            if (j.done) {
+                j.done(result);
+            } else {
+                j.promise.set_value(std::move(result));
+            }
+        }
+
+        // Stops the job from starting any more pieces; the caller must hold the mutex. Returns
+        // true if no pieces are in progress either, and the job may be delivered right away.
+        auto drop(job& j) -> bool {
+            j.cancelled = true;
+            if (j.queued) {
+                j.unfinished -= j.pieces - j.next;
+                j.next = j.pieces;
+                dequeue(j);
+            }
+            return j.unfinished == 0;
+        }
+
+        auto cancel(job& j) -> bool {
+            {
+                std::lock_guard<std::mutex> lock { mutex };
+                if (j.cancelled || j.unfinished == 0) {
+                    return false;
+                }
+                if (!drop(j)) {
+                    // The worker that finishes the last piece in progress delivers the chunk.
+                    return true;
+                }
+            }
+            deliver(j, true);
+            return true;
+        }
+
+        auto piece(job& j, int index) -> void {
+            noise_region<T> const& region = j.region;
+            int const x = (index % j.columns) * engine_tile_size;
+            int const y = (index / j.columns) * engine_tile_size;
+            int const w = (region.width - x < engine_tile_size) ? region.width - x : engine_tile_size;
+            int const h = (region.height - y < engine_tile_size) ? region.height - y : engine_tile_size;
+
+            T* const tile = j.samples.data() + static_cast<long long>(y) * region.width + x;
+            T const x0 = region.x0 + T(x) * region.scale;
+            T const y0 = region.y0 + T(y) * region.scale;
+            fbm_fill_2d(*j.perm, tile, region.width, w, h, x0, y0, region.scale, j.f);
+        }
+
+        auto worker() -> void {
+            for (;;) {
+                std::shared_ptr<job> j;
+                int index = 0;
+                {
+                    std::unique_lock<std::mutex> lock { mutex };
+                    wake.wait(lock, [&] { return stopping || !queue.empty(); });
+                    if (stopping) {
+                        return;
+                    }
+
+                    std::size_t const i = best();
+                    j = queue[i];
+                    index = j->next++;
+                    if (j->next == j->pieces) {
+                        dequeue(*j);
+                    }
+                }
+
+                piece(*j, index);
+
+                bool finished = false;
+                bool cancelled = false;
+                {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    finished = --j->unfinished == 0;
+                    cancelled = j->cancelled;
+                }
+                if (finished) {
+                    deliver(*j, cancelled);
+                }
+            }
+        }
+    };
+
+    template<typename T>
+    auto chunk_generator<T>::ticket::cancel() -> bool {
+        return m_job ? m_state->cancel(*m_job) : false;
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::ticket::set_priority(int priority) -> void {
+        if (m_job) {
+            std::lock_guard<std::mutex> lock { m_state->mutex };
+            m_job->priority = priority;
+        }
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::ticket::ready() const -> bool {
+        return m_job && m_job->delivered.load(std::memory_order_acquire);
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::ticket::get() -> chunk<T> {
+        return m_future.get();
+    }
+
+    template<typename T>
+    chunk_generator<T>::chunk_generator(unsigned threads) : m_state { std::make_shared<state>() } {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        if (threads == 0) {
+            threads = 1;
+        }
+
+        m_state->count = threads;
+        for (unsigned i = 0; i < threads; ++i) {
+            m_threads.emplace_back(&state::worker, m_state.get());
+        }
+    }
+
+    template<typename T>
+    chunk_generator<T>::~chunk_generator() {
+        cancel_all();
+        {
+            std::lock_guard<std::mutex> lock { m_state->mutex };
+            m_state->stopping = true;
+        }
+        m_state->wake.notify_all();
+
+        // Workers finish the pieces they have started (and deliver their chunks) before they exit.
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::thread_count() const -> unsigned {
+        return m_state->count;
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::submit(noise_region<T> const& region, int priority) -> ticket {
+        return submit(region, priority, nullptr);
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::submit(noise_region<T> const& region, int priority, callback done) -> ticket {
+        auto& s = *m_state;
+
+        ticket t {};
+        t.m_state = m_state;
+        t.m_job = std::make_shared<job>(region, priority);
+        job& j = *t.m_job;
+        j.done = std::move(done);
+        if (!j.done) {
+            t.m_future = j.promise.get_future();
+        }
+
+        if (region.width <= 0 || region.height <= 0) {
+            j.region.width = (region.width < 0) ? 0 : region.width;
+            j.region.height = (region.height < 0) ? 0 : region.height;
+            state::deliver(j, false);
+            return t;
+        }
+        j.samples.resize(static_cast<std::size_t>(region.width) * static_cast<std::size_t>(region.height));
+
+        {
+            std::lock_guard<std::mutex> lock { s.mutex };
+            j.sequence = s.sequence++;
+            j.unfinished = j.pieces;
+            j.queued = true;
+            s.queue.push_back(t.m_job);
+        }
+        s.wake.notify_all();
+        return t;
+    }
+
+    template<typename T>
+    auto chunk_generator<T>::cancel_all() -> void {
+        std::vector<std::shared_ptr<job>> ready;
+        {
+            std::lock_guard<std::mutex> lock { m_state->mutex };
+            while (!m_state->queue.empty()) {
+                std::shared_ptr<job> const j = m_state->queue.back();
+                if (m_state->drop(*j)) {
+                    ready.push_back(j);
+                }
+            }
+        }
+        for (auto const& j : ready) {
+            state::deliver(*j, true);
+        }
+    }
+}
+
+#ifndef DB_PERLIN_HEADER_ONLY
+
+template class db::chunk_generator<float>;
+template class db::chunk_generator<double>;
+
+#endif // DB_PERLIN_HEADER_ONLY
+
+#endif // DB_PERLIN_IMPL
+
+#endif // DB_PERLIN_ASYNC_HPP
+
+/*
+MIT License
+
+Copyright (c) 2020-2025 Daniils Buts
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
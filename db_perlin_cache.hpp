@@ -0,0 +1,549 @@
+/*
+ * db-perlin - see license at the bottom, no warranty implied, use at your own risk;
+ *     made by daniilsjb (https://github.com/daniilsjb/perlin-noise)
+ *
+ * The following is a cache of square tiles of fractal noise, for applications that request the
+ * same (or overlapping) regions of the noise over and over again, such as map servers. Tiles are
+ * identified by the parameters of the noise, their coordinates, and their level of detail, and
+ * are generated on the first request only. Every later request for the same tile returns a
+ * pointer to the stored samples, without copying them.
+ *
+ * The tiles are stored in a fixed number of slots of a memory-mapped file, so the cache may hold
+ * far more tiles than would fit into memory, with the operating system paging the recently used
+ * ones in. The index of the slots and their order of use are kept in memory: once all slots are
+ * taken, the least recently used tile is replaced. The file persists between runs, so the tiles
+ * generated by one run are reused by the next one. Without a file (or on systems without memory
+ * mapping), the slots are kept in memory instead.
+ *
+ * Usage:
+ *
+ * This header follows the same conventions as db_perlin.hpp, and must be included after it:
+ *
+ * ```cpp
+ * #define DB_PERLIN_IMPL
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_cache.hpp"
+ * ```
+ *
+ * Create the cache once with the size of its tiles and the number of slots, and then request
+ * tiles from any number of threads:
+ *
+ * ```cpp
+ * db::tile_cache cache { "tiles.cache", 256, 16384 }; // 256x256 samples, 4 GiB on disk.
+ *
+ * db::cache_params params {};
+ * params.scale = 1.0f / 256.0f;
+ * params.octaves = 8;
+ *
+ * db::tile_cache::tile const tile = cache.get(params, tx, ty, lod);
+ * float const sample = tile.data()[j * tile.size() + i];
+ * ```
+ *
+ * A tile is pinned in its slot for as long as the object returned by `get` exists, so release
+ * the tiles once they are no longer needed. If every slot is pinned, the tile is generated into
+ * a private buffer instead. Regions that span several tiles may be copied out with `read`.
+ *
+ * A cache file must not be used by several processes at the same time.
+ */
+
+#ifndef DB_PERLIN_CACHE_HPP
+#define DB_PERLIN_CACHE_HPP
+
+#ifndef DB_PERLIN_HPP
+#error "Please, include db_perlin.hpp before db_perlin_cache.hpp"
+#endif
+
+#include <cstddef>
+#include <memory>
+
+namespace db {
+    struct cache_params {
+        float scale = 1.0f;                       // The distance between neighbouring samples at level of detail 0.
+        int octaves = 1;                          // The number of octaves to sum up (see `db::fractal`).
+        float lacunarity = 2.0f;                  // The frequency multiplier between octaves.
+        float gain = 0.5f;                        // The amplitude multiplier between octaves.
+        perlin_generator const* generator = nullptr; // The instance of the noise (null for the default one).
+    };
+
+    class tile_cache {
+    public:
+        // A tile of `size() * size()` samples in row-major order. Tile (tx, ty) at level of detail
+        // `lod` starts at (tx, ty) * size() * step, where step = scale * 2^lod is the distance
+        // between its samples. The samples stay valid for as long as the object exists.
+        class tile {
+        public:
+            tile() = default;
+            tile(tile&& other) noexcept;
+            auto operator=(tile&& other) noexcept -> tile&;
+            ~tile();
+
+            auto data() const -> float const* { return m_data; }
+            auto size() const -> int { return m_size; }
+
+        private:
+            friend class tile_cache;
+
+            tile_cache* m_cache = nullptr;
+            int m_slot = -1;
+            int m_size = 0;
+            float const* m_data = nullptr;
+            std::unique_ptr<float[]> m_owned;
+        };
+
+        // Opens (or creates) the cache file at `path` with `capacity` slots for tiles of `tile_size`
+        // samples on each side. A file created with different dimensions is cleared. Pass a null
+        // path to keep the cache in memory only.
+        tile_cache(char const* path, int tile_size, std::size_t capacity);
+        ~tile_cache();
+
+        tile_cache(tile_cache const&) = delete;
+        auto operator=(tile_cache const&) -> tile_cache& = delete;
+
+        auto tile_size() const -> int;
+        auto capacity() const -> std::size_t;
+
+        // Whether the tiles are stored in a file (false if it could not be opened or mapped).
+        auto persistent() const -> bool;
+
+        auto get(cache_params const& params, int tx, int ty, int lod) -> tile;
+
+        // Copies the samples [x, x + width) x [y, y + height) at the given level of detail into
+        // `out` (row-major), assembling them from the tiles that cover the region.
+        auto read(cache_params const& params, int lod, long long x, long long y, int width, int height, float* out) -> void;
+
+    private:
+        struct state;
+        std::unique_ptr<state> m_state;
+
+        auto release(int slot) -> void;
+    };
+}
+
+#ifdef DB_PERLIN_IMPL
+
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DB_PERLIN_CACHE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace db {
+    // Identifies a tile; stored in the header of its slot, so it must not contain any padding.
+    struct cache_key {
+        std::uint64_t seed;
+        float scale;
+        float lacunarity;
+        float gain;
+        std::int32_t octaves;
+        std::int32_t tx;
+        std::int32_t ty;
+        std::int32_t lod;
+        std::uint32_t seeded;
+    };
+
+    struct cache_key_hash {
+        auto operator()(cache_key const& key) const -> std::size_t {
+            unsigned char bytes[sizeof(cache_key)];
+            std::memcpy(bytes, &key, sizeof(bytes));
+
+            // FNV-1a over the bytes of the key.
+            std::uint64_t hash = 0xCBF29CE484222325ull;
+            for (unsigned char const byte : bytes) {
+                hash = (hash ^ byte) * 0x100000001B3ull;
+            }
+            return std::size_t(hash);
+        }
+    };
+
+    struct cache_key_equal {
+        auto operator()(cache_key const& a, cache_key const& b) const -> bool {
+            return std::memcmp(&a, &b, sizeof(cache_key)) == 0;
+        }
+    };
+
+    struct cache_file_header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t tile_size;
+        std::uint64_t capacity;
+        unsigned char reserved[40];
+    };
+
+    struct cache_slot_header {
+        cache_key key;
+        std::uint32_t valid;
+        unsigned char reserved[20];
+    };
+
+    static_assert(sizeof(cache_key) == 40, "cache keys must not contain padding");
+    static_assert(sizeof(cache_file_header) == 64, "unexpected size of the cache file header");
+    static_assert(sizeof(cache_slot_header) == 64, "unexpected size of the cache slot header");
+
+    static constexpr char cache_magic[8] = { 'D', 'B', 'P', 'E', 'R', 'L', 'I', 'N' };
+    static constexpr std::uint32_t cache_version = 1;
+
+    struct tile_cache::state {
+        int tile_size = 0;
+        std::size_t capacity = 0;
+        std::size_t stride = 0;
+
+        unsigned char* storage = nullptr;
+        std::size_t storage_size = 0;
+        std::unique_ptr<unsigned char[]> memory;
+        int file = -1;
+
+        std::mutex mutex;
+        std::condition_variable loaded;
+        std::unordered_map<cache_key, int, cache_key_hash, cache_key_equal> index;
+        std::list<int> order; // Slots in use, from the most to the least recently used.
+        std::vector<std::list<int>::iterator> positions;
+        std::vector<int> pins;
+        std::vector<bool> loading;
+        std::vector<int> free;
+
+        auto slot_header(int slot) -> cache_slot_header* {
+            return reinterpret_cast<cache_slot_header*>(storage + sizeof(cache_file_header) + std::size_t(slot) * stride);
+        }
+
+        auto slot_data(int slot) -> float* {
+            return reinterpret_cast<float*>(storage + sizeof(cache_file_header) + std::size_t(slot) * stride + sizeof(cache_slot_header));
+        }
+
+        auto map(char const* path) -> bool {
+#if DB_PERLIN_CACHE_MMAP
+            if (path == nullptr) {
+                return false;
+            }
+
+            file = ::open(path, O_RDWR | O_CREAT, 0644);
+            if (file < 0) {
+                return false;
+            }
+
+            struct stat info {};
+            bool const reuse = ::fstat(file, &info) == 0 && std::size_t(info.st_size) == storage_size;
+            if (!reuse && (::ftruncate(file, 0) != 0 || ::ftruncate(file, off_t(storage_size)) != 0)) {
+                ::close(file);
+                file = -1;
+                return false;
+            }
+
+            void* const address = ::mmap(nullptr, storage_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            if (address == MAP_FAILED) {
+                ::close(file);
+                file = -1;
+                return false;
+            }
+
+            storage = static_cast<unsigned char*>(address);
+            return true;
+#else
+            (void) path;
+            return false;
+#endif
+        }
+
+        auto unmap() -> void {
+#if DB_PERLIN_CACHE_MMAP
+            if (file >= 0) {
+                ::munmap(storage, storage_size);
+                ::close(file);
+            }
+#endif
+        }
+
+        auto touch(int slot) -> void {
+            order.splice(order.begin(), order, positions[std::size_t(slot)]);
+        }
+    };
+
+    static auto cache_generate(cache_params const& params, int size, int tx, int ty, int lod, float* out) -> void {
+        fractal<float> const f { params.octaves, params.lacunarity, params.gain };
+        permutation const& perm = params.generator ? params.generator->table() : default_permutation;
+
+        float const step = std::ldexp(params.scale, lod);
+        // The origin is computed in double, so that tiles far from zero still start where the
+        // previous ones end, rather than at the nearest float to their first sample index.
+        float const x0 = float(double(tx) * size * step);
+        float const y0 = float(double(ty) * size * step);
+        fbm_fill_2d(perm, out, size, size, size, x0, y0, step, f);
+    }
+
+    DB_PERLIN_INLINE tile_cache::tile::tile(tile&& other) noexcept
+        : m_cache { other.m_cache }
+        , m_slot { other.m_slot }
+        , m_size { other.m_size }
+        , m_data { other.m_data }
+        , m_owned { std::move(other.m_owned) } {
+        other.m_cache = nullptr;
+        other.m_slot = -1;
+        other.m_data = nullptr;
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::tile::operator=(tile&& other) noexcept -> tile& {
+        if (this != &other) {
+            if (m_cache != nullptr) {
+                m_cache->release(m_slot);
+            }
+
+            m_cache = other.m_cache;
+            m_slot = other.m_slot;
+            m_size = other.m_size;
+            m_data = other.m_data;
+            m_owned = std::move(other.m_owned);
+
+            other.m_cache = nullptr;
+            other.m_slot = -1;
+            other.m_data = nullptr;
+        }
+        return *this;
+    }
+
+    DB_PERLIN_INLINE tile_cache::tile::~tile() {
+        if (m_cache != nullptr) {
+            m_cache->release(m_slot);
+        }
+    }
+
+    DB_PERLIN_INLINE tile_cache::tile_cache(char const* path, int tile_size, std::size_t capacity) : m_state { new state {} } {
+        auto& s = *m_state;
+        s.tile_size = (tile_size < 1) ? 1 : tile_size;
+        s.capacity = (capacity < 1) ? 1 : capacity;
+
+        // Slots are aligned to cache lines, so the samples of every tile are aligned as well.
+        std::size_t const samples = std::size_t(s.tile_size) * std::size_t(s.tile_size) * sizeof(float);
+        s.stride = (sizeof(cache_slot_header) + samples + 63) / 64 * 64;
+        s.storage_size = sizeof(cache_file_header) + s.capacity * s.stride;
+
+        // Without a file, the store lives in memory, where only the headers are zeroed: the samples
+        // of a slot are always generated before they are read.
+        if (!s.map(path)) {
+            s.memory.reset(new unsigned char[s.storage_size]);
+            s.storage = s.memory.get();
+
+            std::memset(s.storage, 0, sizeof(cache_file_header));
+            for (std::size_t i = 0; i < s.capacity; ++i) {
+                std::memset(s.slot_header(int(i)), 0, sizeof(cache_slot_header));
+            }
+        }
+
+        // A file written with the same layout still holds valid tiles, which go back into the index;
+        // in any other file, every slot is marked as free. The samples themselves are never wiped,
+        // which keeps the pages of a new file from being touched until they are actually used.
+        auto* const header = reinterpret_cast<cache_file_header*>(s.storage);
+        bool const compatible = std::memcmp(header->magic, cache_magic, sizeof(cache_magic)) == 0
+            && header->version == cache_version
+            && header->tile_size == std::uint32_t(s.tile_size)
+            && header->capacity == std::uint64_t(s.capacity);
+
+        if (!compatible) {
+            std::memset(header, 0, sizeof(cache_file_header));
+            std::memcpy(header->magic, cache_magic, sizeof(cache_magic));
+            header->version = cache_version;
+            header->tile_size = std::uint32_t(s.tile_size);
+            header->capacity = std::uint64_t(s.capacity);
+        }
+
+        s.positions.resize(s.capacity);
+        s.pins.assign(s.capacity, 0);
+        s.loading.assign(s.capacity, false);
+
+        for (std::size_t i = s.capacity; i-- > 0;) {
+            int const slot = int(i);
+            cache_slot_header* const slot_header = s.slot_header(slot);
+            if (compatible && slot_header->valid != 0 && s.index.emplace(slot_header->key, slot).second) {
+                s.positions[i] = s.order.insert(s.order.end(), slot);
+                continue;
+            }
+
+            if (slot_header->valid != 0) {
+                slot_header->valid = 0;
+            }
+            s.free.push_back(slot);
+        }
+    }
+
+    DB_PERLIN_INLINE tile_cache::~tile_cache() {
+        m_state->unmap();
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::tile_size() const -> int {
+        return m_state->tile_size;
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::capacity() const -> std::size_t {
+        return m_state->capacity;
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::persistent() const -> bool {
+        return m_state->file >= 0;
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::get(cache_params const& params, int tx, int ty, int lod) -> tile {
+        auto& s = *m_state;
+
+        cache_key key {};
+        key.seed = params.generator ? params.generator->seed() : 0;
+        key.scale = params.scale;
+        key.lacunarity = params.lacunarity;
+        key.gain = params.gain;
+        key.octaves = params.octaves;
+        key.tx = tx;
+        key.ty = ty;
+        key.lod = lod;
+        key.seeded = params.generator ? 1 : 0;
+
+        tile result {};
+        result.m_size = s.tile_size;
+
+        std::unique_lock<std::mutex> lock { s.mutex };
+        for (;;) {
+            auto const found = s.index.find(key);
+            if (found == s.index.end()) {
+                break;
+            }
+
+            int const slot = found->second;
+            if (s.loading[std::size_t(slot)]) {
+                // Another thread is generating this very tile; the slot may have been reused by
+                // the time it is done, so the lookup is repeated afterwards.
+                s.loaded.wait(lock);
+                continue;
+            }
+
+            ++s.pins[std::size_t(slot)];
+            s.touch(slot);
+            DB_PERLIN_PROFILE_CACHE(1, 0, 0);
+
+            result.m_cache = this;
+            result.m_slot = slot;
+            result.m_data = s.slot_data(slot);
+            return result;
+        }
+
+        int slot = -1;
+        if (!s.free.empty()) {
+            slot = s.free.back();
+            s.free.pop_back();
+            s.positions[std::size_t(slot)] = s.order.insert(s.order.begin(), slot);
+        } else {
+            for (auto it = s.order.rbegin(); it != s.order.rend(); ++it) {
+                if (s.pins[std::size_t(*it)] == 0) {
+                    slot = *it;
+                    break;
+                }
+            }
+
+            if (slot < 0) {
+                // Every slot is in use, so the tile cannot be cached; it is still generated, but
+                // into a buffer owned by the caller.
+                lock.unlock();
+                DB_PERLIN_PROFILE_CACHE(0, 1, 0);
+                result.m_owned.reset(new float[std::size_t(s.tile_size) * std::size_t(s.tile_size)]);
+                cache_generate(params, s.tile_size, tx, ty, lod, result.m_owned.get());
+                result.m_data = result.m_owned.get();
+                return result;
+            }
+
+            s.index.erase(s.slot_header(slot)->key);
+            s.touch(slot);
+            DB_PERLIN_PROFILE_CACHE(0, 0, 1);
+        }
+
+        // The slot is pinned and marked as loading, so it can neither be evicted nor read until
+        // its tile is generated, which happens without holding the lock.
+        cache_slot_header* const header = s.slot_header(slot);
+        header->valid = 0;
+        header->key = key;
+        s.index.emplace(key, slot);
+        s.pins[std::size_t(slot)] = 1;
+        s.loading[std::size_t(slot)] = true;
+        lock.unlock();
+        DB_PERLIN_PROFILE_CACHE(0, 1, 0);
+
+        cache_generate(params, s.tile_size, tx, ty, lod, s.slot_data(slot));
+
+        lock.lock();
+        header->valid = 1;
+        s.loading[std::size_t(slot)] = false;
+        lock.unlock();
+        s.loaded.notify_all();
+
+        result.m_cache = this;
+        result.m_slot = slot;
+        result.m_data = s.slot_data(slot);
+        return result;
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::read(cache_params const& params, int lod, long long x, long long y, int width, int height, float* out) -> void {
+        long long const size = m_state->tile_size;
+
+        // Floor division, so that regions with negative coordinates map onto the right tiles.
+        auto const tile_of = [size](long long v) { return (v >= 0) ? v / size : -((-v + size - 1) / size); };
+
+        for (long long ty = tile_of(y); ty * size < y + height; ++ty) {
+            for (long long tx = tile_of(x); tx * size < x + width; ++tx) {
+                tile const t = get(params, int(tx), int(ty), lod);
+
+                long long const x_begin = (tx * size > x) ? tx * size : x;
+                long long const y_begin = (ty * size > y) ? ty * size : y;
+                long long const x_end = ((tx + 1) * size < x + width) ? (tx + 1) * size : x + width;
+                long long const y_end = ((ty + 1) * size < y + height) ? (ty + 1) * size : y + height;
+
+                for (long long row = y_begin; row < y_end; ++row) {
+                    float const* const source = t.data() + (row - ty * size) * size + (x_begin - tx * size);
+                    float* const target = out + (row - y) * width + (x_begin - x);
+                    std::memcpy(target, source, std::size_t(x_end - x_begin) * sizeof(float));
+                }
+            }
+        }
+    }
+
+    DB_PERLIN_INLINE auto tile_cache::release(int slot) -> void {
+        if (slot < 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock { m_state->mutex };
+        --m_state->pins[std::size_t(slot)];
+    }
+}
+
+#endif // DB_PERLIN_IMPL
+
+#endif // DB_PERLIN_CACHE_HPP
+
+/*
+MIT License
+
+Copyright (c) 2020-2025 Daniils Buts
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
@@ -0,0 +1,335 @@
+/*
+ * db-perlin - see license at the bottom, no warranty implied, use at your own risk;
+ *     made by daniilsjb (https://github.com/daniilsjb/perlin-noise)
+ *
+ * The following is a multithreaded noise generation engine built on top of the grid-filling
+ * functions of the library. A region of noise is split into small square tiles, which are then
+ * distributed across a pool of worker threads. Each worker starts with its own contiguous share
+ * of the tiles and, once it runs out, steals tiles from the other workers, so the load stays
+ * balanced even when some threads are slowed down by other work on the machine.
+ *
+ * The tiles never overlap and every sample is computed independently of how the tiles are
+ * assigned to threads, so the output is the same regardless of the number of threads, and no
+ * locks are needed to write it.
+ *
+ * Usage:
+ *
+ * This header follows the same conventions as db_perlin.hpp, and must be included after it. The
+ * implementation is compiled in the source file which defines `DB_PERLIN_IMPL`:
+ *
+ * ```cpp
+ * #define DB_PERLIN_IMPL
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_engine.hpp"
+ * ```
+ *
+ * An engine owns its threads for its entire lifetime, so it is best to create one and reuse it
+ * for all requests. Describe the region to generate and pass a buffer to hold its samples:
+ *
+ * ```cpp
+ * db::noise_engine engine {};
+ *
+ * db::noise_region<float> region {};
+ * region.width = 4096;
+ * region.height = 4096;
+ * region.scale = 1.0f / 64.0f;
+ * region.octaves = 6;
+ *
+ * std::vector<float> heightmap(region.width * region.height);
+ * engine.generate(region, heightmap.data());
+ * ```
+ *
+ * To generate a particular instance of the noise, point `region.generator` to a seeded generator.
+ * The generator must outlive the call to `generate`.
+ *
+ * The calling thread takes part in the work, so an engine with a single thread does not spawn
+ * any threads at all. Calls to `generate` from several threads are safe but are executed one
+ * after another.
+ */
+
+#ifndef DB_PERLIN_ENGINE_HPP
+#define DB_PERLIN_ENGINE_HPP
+
+#ifndef DB_PERLIN_HPP
+#error "Please, include db_perlin.hpp before db_perlin_engine.hpp"
+#endif
+
+#include <functional>
+#include <memory>
+
+namespace db {
+    template<typename T>
+    struct noise_region {
+        int width = 0;                    // The number of samples along the x-axis.
+        int height = 0;                   // The number of samples along the y-axis.
+        T x0 = T(0.0);                    // The x-coordinate of the first sample.
+        T y0 = T(0.0);                    // The y-coordinate of the first sample.
+        T scale = T(1.0);                 // The distance between neighbouring samples.
+        int octaves = 1;                  // The number of octaves to sum up (see `db::fractal`).
+        T lacunarity = T(2.0);            // The frequency multiplier between octaves.
+        T gain = T(0.5);                  // The amplitude multiplier between octaves.
+        perlin_generator const* generator = nullptr; // The instance of the noise (null for the default one).
+    };
+
+    class noise_engine {
+    public:
+        // Creates an engine with the given total number of threads (including the calling
+        // thread). Zero picks the number of hardware threads available on the machine.
+        explicit noise_engine(unsigned threads = 0);
+        ~noise_engine();
+
+        noise_engine(noise_engine const&) = delete;
+        auto operator=(noise_engine const&) -> noise_engine& = delete;
+
+        auto thread_count() const -> unsigned;
+
+        // Fills `out` (row-major, `region.width * region.height` samples) with the fractal
+        // noise of the region, as described by `db::fbm`.
+        template<typename T>
+        auto generate(noise_region<T> const& region, T* out) -> void;
+
+        // Splits a grid into tiles and calls `fn(x, y, width, height)` for each of them from
+        // the worker threads. Returns once all tiles have been processed.
+        auto for_each_tile(int width, int height, std::function<void(int, int, int, int)> const& fn) -> void;
+
+    private:
+        struct state;
+        std::unique_ptr<state> m_state;
+    };
+}
+
+#ifdef DB_PERLIN_IMPL
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace db {
+    // Tiles of 64x64 samples fit into the L1 cache even for doubles with an octave accumulator,
+    // and are still large enough for the per-tile overhead to be negligible.
+    static constexpr int engine_tile_size = 64;
+
+    struct noise_engine::state {
+        struct queue {
+            std::mutex mutex;
+            std::deque<int> tiles;
+        };
+
+        std::vector<std::thread> threads;
+        std::unique_ptr<queue[]> queues;
+        unsigned count = 0;
+
+        // Describes the current job; only modified while no worker is busy.
+        std::function<void(int)> task;
+        std::atomic<int> remaining { 0 };
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        std::uint64_t generation = 0;
+        unsigned busy = 0;
+        bool stopping = false;
+
+        // Serializes concurrent calls into the engine.
+        std::mutex submit;
+
+        auto pop(unsigned self, int& tile) -> bool {
+            // The owner takes tiles from the back of its own queue...
+            auto& q = queues[self];
+            std::lock_guard<std::mutex> lock { q.mutex };
+            if (q.tiles.empty()) {
+                return false;
+            }
+            tile = q.tiles.back();
+            q.tiles.pop_back();
+            return true;
+        }
+
+        auto steal(unsigned self, int& tile) -> bool {
+            // ...while thieves take them from the front, so they rarely contend with the owner.
+            for (unsigned k = 1; k < count; ++k) {
+                auto& q = queues[(self + k) % count];
+                std::lock_guard<std::mutex> lock { q.mutex };
+                if (!q.tiles.empty()) {
+                    tile = q.tiles.front();
+                    q.tiles.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        auto work(unsigned self) -> void {
+            int tile = 0;
+            while (pop(self, tile) || steal(self, tile)) {
+                task(tile);
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    done.notify_all();
+                }
+            }
+        }
+
+        auto worker(unsigned self) -> void {
+            std::uint64_t seen = 0;
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock { mutex };
+                    wake.wait(lock, [&] { return stopping || generation != seen; });
+                    if (stopping) {
+                        return;
+                    }
+                    seen = generation;
+                    ++busy;
+                }
+
+                work(self);
+
+                {
+                    std::lock_guard<std::mutex> lock { mutex };
+                    --busy;
+                }
+                done.notify_all();
+            }
+        }
+    };
+
+    DB_PERLIN_INLINE noise_engine::noise_engine(unsigned threads) : m_state { new state {} } {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        if (threads == 0) {
+            threads = 1;
+        }
+
+        m_state->count = threads;
+        m_state->queues.reset(new state::queue[threads]);
+
+        // The calling thread acts as worker 0, so only the rest of them need to be spawned.
+        for (unsigned i = 1; i < threads; ++i) {
+            m_state->threads.emplace_back(&state::worker, m_state.get(), i);
+        }
+    }
+
+    DB_PERLIN_INLINE noise_engine::~noise_engine() {
+        {
+            std::lock_guard<std::mutex> lock { m_state->mutex };
+            m_state->stopping = true;
+        }
+        m_state->wake.notify_all();
+
+        for (auto& thread : m_state->threads) {
+            thread.join();
+        }
+    }
+
+    DB_PERLIN_INLINE auto noise_engine::thread_count() const -> unsigned {
+        return m_state->count;
+    }
+
+    DB_PERLIN_INLINE auto noise_engine::for_each_tile(int width, int height, std::function<void(int, int, int, int)> const& fn) -> void {
+        if (width <= 0 || height <= 0) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit { m_state->submit };
+        auto& s = *m_state;
+
+        int const columns = (width + engine_tile_size - 1) / engine_tile_size;
+        int const rows = (height + engine_tile_size - 1) / engine_tile_size;
+        int const tiles = columns * rows;
+
+        {
+            // A worker that woke up too late for the previous job may still be on its way out,
+            // so the new job may only be set up once every worker has gone back to sleep.
+            std::unique_lock<std::mutex> lock { s.mutex };
+            s.done.wait(lock, [&] { return s.busy == 0; });
+
+            s.task = [&](int tile) {
+                int const x = (tile % columns) * engine_tile_size;
+                int const y = (tile / columns) * engine_tile_size;
+                int const w = (width - x < engine_tile_size) ? width - x : engine_tile_size;
+                int const h = (height - y < engine_tile_size) ? height - y : engine_tile_size;
+                fn(x, y, w, h);
+            };
+
+            // Each worker starts with a contiguous run of tiles, which keeps neighbouring tiles
+            // (and the rows of the output they write to) on the same thread until stealing begins.
+            for (unsigned i = 0; i < s.count; ++i) {
+                int const begin = int(static_cast<long long>(tiles) * i / s.count);
+                int const end = int(static_cast<long long>(tiles) * (i + 1) / s.count);
+
+                std::lock_guard<std::mutex> queue_lock { s.queues[i].mutex };
+                for (int tile = begin; tile < end; ++tile) {
+                    s.queues[i].tiles.push_back(tile);
+                }
+            }
+
+            s.remaining.store(tiles, std::memory_order_release);
+            ++s.generation;
+        }
+        s.wake.notify_all();
+
+        s.work(0);
+
+        // Workers may still be looking for tiles to steal, so the job may only be torn down
+        // once every one of them is done with it.
+        std::unique_lock<std::mutex> lock { s.mutex };
+        s.done.wait(lock, [&] { return s.remaining.load(std::memory_order_acquire) == 0 && s.busy == 0; });
+        s.task = nullptr;
+    }
+
+    template<typename T>
+    auto noise_engine::generate(noise_region<T> const& region, T* out) -> void {
+        DB_PERLIN_PROFILE_ZONE("noise_engine::generate");
+
+        fractal<T> const f { region.octaves, region.lacunarity, region.gain };
+        permutation const& perm = region.generator ? region.generator->table() : default_permutation;
+
+        for_each_tile(region.width, region.height, [&](int x, int y, int w, int h) {
+            T* const tile = out + static_cast<long long>(y) * region.width + x;
+            T const tx = region.x0 + T(x) * region.scale;
+            T const ty = region.y0 + T(y) * region.scale;
+            fbm_fill_2d(perm, tile, region.width, w, h, tx, ty, region.scale, f);
+        });
+    }
+}
+
+#ifndef DB_PERLIN_HEADER_ONLY
+
+template auto db::noise_engine::generate<float>(noise_region<float> const& region, float* out) -> void;
+template auto db::noise_engine::generate<double>(noise_region<double> const& region, double* out) -> void;
+
+#endif // DB_PERLIN_HEADER_ONLY
+
+#endif // DB_PERLIN_IMPL
+
+#endif // DB_PERLIN_ENGINE_HPP
+
+/*
+MIT License
+
+Copyright (c) 2020-2025 Daniils Buts
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
@@ -0,0 +1,544 @@
+/*
+ * db-perlin - see license at the bottom, no warranty implied, use at your own risk;
+ *     made by daniilsjb (https://github.com/daniilsjb/perlin-noise)
+ *
+ * The following is a small language for composing noise functions: domain warping, octaves,
+ * blend masks, and remap curves are nodes of an expression, which is built with ordinary C++
+ * operators and function calls. Every node is a distinct type, so the compiler sees the entire
+ * expression at once and turns it into a single kernel that computes one sample from start to
+ * finish. Filling a grid with a composition therefore needs no intermediate buffers for its
+ * stages (unlike chaining several grid fills), and each sample stays in registers until it is
+ * written to the output.
+ *
+ * The nodes compute exactly the same values as the equivalent calls to the library, in the same
+ * order, so `fbm(perlin<float>(), f)` at (x, y) is equal to `db::fbm(x, y, f)`.
+ *
+ * Usage:
+ *
+ * This header follows the same conventions as db_perlin.hpp, and must be included after it and
+ * after db_perlin_engine.hpp. The expressions are templates of arbitrary types chosen by the
+ * user, so the whole header is compiled wherever it is included and needs no implementation:
+ *
+ * ```cpp
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_engine.hpp"
+ * #include "db_perlin_graph.hpp"
+ * ```
+ *
+ * The nodes live in the `db::graph` namespace. Leaves (`perlin`, `simplex`, `constant`) take the
+ * type of the samples as a template argument, and every other node picks it up from its inputs:
+ *
+ * ```cpp
+ * namespace g = db::graph;
+ *
+ * auto const offset = g::fbm(g::perlin<float>(), db::fractal<float> { 3 });
+ * auto const base = g::warp(g::fbm(g::perlin<float>(), db::fractal<float> { 6 }),
+ *                           g::translate(offset, 5.2f, 1.3f), g::translate(offset, 1.7f, 9.2f), 4.0f);
+ * auto const mountains = g::ridged(g::scale(g::perlin<float>(), 0.5f), db::fractal<float> { 5 });
+ * auto const terrain = g::remap(g::blend(base, mountains, base * 2.0f + 0.5f), -1.0f, 1.0f, 0.0f, 1.0f);
+ *
+ * float sample = terrain(x, y);
+ * g::fill_2d(terrain, heightmap.data(), width, height, x0, y0, step);
+ * g::generate(engine, terrain, heightmap.data(), width, height, x0, y0, step);
+ * ```
+ *
+ * Expressions are small immutable values which hold their inputs by value, so they may be copied,
+ * reused as inputs of several other expressions, and evaluated from any number of threads. Each
+ * use of an input is evaluated separately, however, so an input used twice costs twice as much.
+ *
+ * Every node can be evaluated both in 2D and in 3D. The warping node only displaces the x and y
+ * coordinates, so in 3D the third one (e.g., time) passes through unchanged.
+ *
+ * Grids are evaluated through the same kernel, one scalar sample at a time: `fill_2d`, `fill_3d`,
+ * and `generate` never reach the batched grid fills or the SIMD kernels of the library, even for
+ * an expression that is plain `perlin` or `fbm` of it. `generate` spreads the samples over the
+ * threads of the engine, but each thread still computes them one by one. For plain noise or fBm
+ * over a grid, `perlin_fill_2d`, `fbm_fill_2d`, and `noise_engine` remain the faster choice.
+ */
+
+#ifndef DB_PERLIN_GRAPH_HPP
+#define DB_PERLIN_GRAPH_HPP
+
+#ifndef DB_PERLIN_HPP
+#error "Please, include db_perlin.hpp before db_perlin_graph.hpp"
+#endif
+
+#ifndef DB_PERLIN_ENGINE_HPP
+#error "Please, include db_perlin_engine.hpp before db_perlin_graph.hpp"
+#endif
+
+namespace db {
+    namespace graph {
+        // Base of every node, which marks the types the operators below apply to.
+        template<typename D>
+        struct node {
+            constexpr auto self() const -> D const& {
+                return static_cast<D const&>(*this);
+            }
+        };
+
+        template<typename T>
+        struct perlin_node : node<perlin_node<T>> {
+            using value_type = T;
+            perlin_generator const* generator;
+
+            constexpr explicit perlin_node(perlin_generator const* generator_)
+                : generator { generator_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return generator ? generator->perlin(x, y) : db::perlin(x, y);
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return generator ? generator->perlin(x, y, z) : db::perlin(x, y, z);
+            }
+        };
+
+        template<typename T>
+        struct simplex_node : node<simplex_node<T>> {
+            using value_type = T;
+            perlin_generator const* generator;
+
+            constexpr explicit simplex_node(perlin_generator const* generator_)
+                : generator { generator_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return generator ? generator->simplex(x, y) : db::simplex(x, y);
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return generator ? generator->simplex(x, y, z) : db::simplex(x, y, z);
+            }
+        };
+
+        template<typename T>
+        struct constant_node : node<constant_node<T>> {
+            using value_type = T;
+            T value;
+
+            constexpr explicit constant_node(T value_)
+                : value { value_ } {}
+
+            constexpr auto operator()(T, T) const -> T {
+                return value;
+            }
+
+            constexpr auto operator()(T, T, T) const -> T {
+                return value;
+            }
+        };
+
+        // Applies `op` to the value of the input.
+        template<typename A, typename F>
+        struct unary_node : node<unary_node<A, F>> {
+            using value_type = typename A::value_type;
+            using T = value_type;
+            A a;
+            F op;
+
+            constexpr unary_node(A const& a_, F const& op_)
+                : a { a_ }, op { op_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return op(a(x, y));
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return op(a(x, y, z));
+            }
+        };
+
+        // Applies `op` to the values of both inputs at the same point.
+        template<typename A, typename B, typename F>
+        struct binary_node : node<binary_node<A, B, F>> {
+            using value_type = typename A::value_type;
+            using T = value_type;
+            A a;
+            B b;
+            F op;
+
+            constexpr binary_node(A const& a_, B const& b_, F const& op_)
+                : a { a_ }, b { b_ }, op { op_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return op(a(x, y), b(x, y));
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return op(a(x, y, z), b(x, y, z));
+            }
+        };
+
+        // Interpolates between the inputs, with the mask clamped to [0, 1].
+        template<typename A, typename B, typename M>
+        struct blend_node : node<blend_node<A, B, M>> {
+            using value_type = typename A::value_type;
+            using T = value_type;
+            A a;
+            B b;
+            M mask;
+
+            constexpr blend_node(A const& a_, B const& b_, M const& mask_)
+                : a { a_ }, b { b_ }, mask { mask_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return mix(a(x, y), b(x, y), mask(x, y));
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return mix(a(x, y, z), b(x, y, z), mask(x, y, z));
+            }
+
+            static constexpr auto mix(T a, T b, T t) -> T {
+                return a + (b - a) * ((t < T(0.0)) ? T(0.0) : (t > T(1.0)) ? T(1.0) : t);
+            }
+        };
+
+        // Evaluates the input at `(x, y, z) * factor + offset`.
+        template<typename A>
+        struct transform_node : node<transform_node<A>> {
+            using value_type = typename A::value_type;
+            using T = value_type;
+            A a;
+            T factor;
+            T ox, oy, oz;
+
+            constexpr transform_node(A const& a_, T factor_, T ox_, T oy_, T oz_)
+                : a { a_ }, factor { factor_ }, ox { ox_ }, oy { oy_ }, oz { oz_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return a(x * factor + ox, y * factor + oy);
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return a(x * factor + ox, y * factor + oy, z * factor + oz);
+            }
+        };
+
+        // Evaluates the input at a point displaced by `strength` times the values of `wx` and `wy`.
+        template<typename A, typename WX, typename WY>
+        struct warp_node : node<warp_node<A, WX, WY>> {
+            using value_type = typename A::value_type;
+            using T = value_type;
+            A a;
+            WX wx;
+            WY wy;
+            T strength;
+
+            constexpr warp_node(A const& a_, WX const& wx_, WY const& wy_, T strength_)
+                : a { a_ }, wx { wx_ }, wy { wy_ }, strength { strength_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                return a(x + strength * wx(x, y), y + strength * wy(x, y));
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                return a(x + strength * wx(x, y, z), y + strength * wy(x, y, z), z);
+            }
+        };
+
+        // Sums up the octaves of the input passed through `shape`, as `db::fbm` does for the noise.
+        template<typename A, typename S>
+        struct octave_node : node<octave_node<A, S>> {
+            using value_type = typename A::value_type;
+            using T = value_type;
+            A a;
+            fractal<T> f;
+            S shape;
+
+            constexpr octave_node(A const& a_, fractal<T> const& f_, S const& shape_)
+                : a { a_ }, f { f_ }, shape { shape_ } {}
+
+            auto operator()(T x, T y) const -> T {
+                T sum = T(0.0);
+                for (int i = 0; i < f.octaves; ++i) {
+                    sum += f.amplitude[i] * shape(a(x * f.frequency[i], y * f.frequency[i]));
+                }
+                return sum / f.total_amplitude;
+            }
+
+            auto operator()(T x, T y, T z) const -> T {
+                T sum = T(0.0);
+                for (int i = 0; i < f.octaves; ++i) {
+                    sum += f.amplitude[i] * shape(a(x * f.frequency[i], y * f.frequency[i], z * f.frequency[i]));
+                }
+                return sum / f.total_amplitude;
+            }
+        };
+
+        // The operations applied by the nodes above.
+        struct add_op { template<typename T> constexpr auto operator()(T a, T b) const -> T { return a + b; } };
+        struct sub_op { template<typename T> constexpr auto operator()(T a, T b) const -> T { return a - b; } };
+        struct mul_op { template<typename T> constexpr auto operator()(T a, T b) const -> T { return a * b; } };
+        struct div_op { template<typename T> constexpr auto operator()(T a, T b) const -> T { return a / b; } };
+        struct min_op { template<typename T> constexpr auto operator()(T a, T b) const -> T { return (b < a) ? b : a; } };
+        struct max_op { template<typename T> constexpr auto operator()(T a, T b) const -> T { return (a < b) ? b : a; } };
+        struct neg_op { template<typename T> constexpr auto operator()(T a) const -> T { return -a; } };
+        struct abs_op { template<typename T> constexpr auto operator()(T a) const -> T { return (a < T(0.0)) ? -a : a; } };
+        struct identity_op { template<typename T> constexpr auto operator()(T a) const -> T { return a; } };
+
+        struct ridge_op {
+            template<typename T>
+            constexpr auto operator()(T a) const -> T {
+                T const r = T(1.0) - ((a < T(0.0)) ? -a : a);
+                return r * r;
+            }
+        };
+
+        template<typename T>
+        struct clamp_op {
+            T lo, hi;
+            constexpr auto operator()(T a) const -> T { return (a < lo) ? lo : (hi < a) ? hi : a; }
+        };
+
+        template<typename T>
+        struct affine_op {
+            T factor, offset;
+            constexpr auto operator()(T a) const -> T { return a * factor + offset; }
+        };
+
+        // Leaves.
+
+        template<typename T>
+        constexpr auto perlin(perlin_generator const* generator = nullptr) -> perlin_node<T> {
+            return perlin_node<T> { generator };
+        }
+
+        template<typename T>
+        constexpr auto simplex(perlin_generator const* generator = nullptr) -> simplex_node<T> {
+            return simplex_node<T> { generator };
+        }
+
+        template<typename T>
+        constexpr auto constant(T value) -> constant_node<T> {
+            return constant_node<T> { value };
+        }
+
+        // Arithmetic between two expressions, or between an expression and a number.
+
+        template<typename A, typename B, typename F>
+        constexpr auto combine(node<A> const& a, node<B> const& b, F op) -> binary_node<A, B, F> {
+            return binary_node<A, B, F> { a.self(), b.self(), op };
+        }
+
+        template<typename A, typename B>
+        constexpr auto operator+(node<A> const& a, node<B> const& b) -> binary_node<A, B, add_op> {
+            return combine(a, b, add_op {});
+        }
+
+        template<typename A, typename B>
+        constexpr auto operator-(node<A> const& a, node<B> const& b) -> binary_node<A, B, sub_op> {
+            return combine(a, b, sub_op {});
+        }
+
+        template<typename A, typename B>
+        constexpr auto operator*(node<A> const& a, node<B> const& b) -> binary_node<A, B, mul_op> {
+            return combine(a, b, mul_op {});
+        }
+
+        template<typename A, typename B>
+        constexpr auto operator/(node<A> const& a, node<B> const& b) -> binary_node<A, B, div_op> {
+            return combine(a, b, div_op {});
+        }
+
+        template<typename A, typename B>
+        constexpr auto min(node<A> const& a, node<B> const& b) -> binary_node<A, B, min_op> {
+            return combine(a, b, min_op {});
+        }
+
+        template<typename A, typename B>
+        constexpr auto max(node<A> const& a, node<B> const& b) -> binary_node<A, B, max_op> {
+            return combine(a, b, max_op {});
+        }
+
+        // The numbers are converted to the type of the samples, so `expr * 0.5` works for floats as well.
+        template<typename A>
+        using number = typename A::value_type;
+
+        template<typename A>
+        constexpr auto operator+(node<A> const& a, number<A> b) -> binary_node<A, constant_node<number<A>>, add_op> {
+            return combine(a, constant(b), add_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator+(number<A> a, node<A> const& b) -> binary_node<constant_node<number<A>>, A, add_op> {
+            return combine(constant(a), b, add_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator-(node<A> const& a, number<A> b) -> binary_node<A, constant_node<number<A>>, sub_op> {
+            return combine(a, constant(b), sub_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator-(number<A> a, node<A> const& b) -> binary_node<constant_node<number<A>>, A, sub_op> {
+            return combine(constant(a), b, sub_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator*(node<A> const& a, number<A> b) -> binary_node<A, constant_node<number<A>>, mul_op> {
+            return combine(a, constant(b), mul_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator*(number<A> a, node<A> const& b) -> binary_node<constant_node<number<A>>, A, mul_op> {
+            return combine(constant(a), b, mul_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator/(node<A> const& a, number<A> b) -> binary_node<A, constant_node<number<A>>, div_op> {
+            return combine(a, constant(b), div_op {});
+        }
+
+        template<typename A>
+        constexpr auto operator-(node<A> const& a) -> unary_node<A, neg_op> {
+            return unary_node<A, neg_op> { a.self(), neg_op {} };
+        }
+
+        // Curves applied to the value of an expression.
+
+        // Passes the value through an arbitrary function object, e.g., a lambda with a custom curve.
+        template<typename A, typename F>
+        constexpr auto map(node<A> const& a, F fn) -> unary_node<A, F> {
+            return unary_node<A, F> { a.self(), fn };
+        }
+
+        template<typename A>
+        constexpr auto abs(node<A> const& a) -> unary_node<A, abs_op> {
+            return map(a, abs_op {});
+        }
+
+        template<typename A>
+        constexpr auto clamp(node<A> const& a, number<A> lo, number<A> hi) -> unary_node<A, clamp_op<number<A>>> {
+            return map(a, clamp_op<number<A>> { lo, hi });
+        }
+
+        // Linearly maps [from_lo, from_hi] onto [to_lo, to_hi] (values outside of the range are extrapolated).
+        template<typename A>
+        constexpr auto remap(node<A> const& a, number<A> from_lo, number<A> from_hi, number<A> to_lo, number<A> to_hi) -> unary_node<A, affine_op<number<A>>> {
+            using T = number<A>;
+            T const factor = (to_hi - to_lo) / (from_hi - from_lo);
+            return map(a, affine_op<T> { factor, to_lo - from_lo * factor });
+        }
+
+        template<typename A, typename B, typename M>
+        constexpr auto blend(node<A> const& a, node<B> const& b, node<M> const& mask) -> blend_node<A, B, M> {
+            return blend_node<A, B, M> { a.self(), b.self(), mask.self() };
+        }
+
+        // Changes to the coordinates an expression is evaluated at.
+
+        template<typename A>
+        constexpr auto scale(node<A> const& a, number<A> factor) -> transform_node<A> {
+            return transform_node<A> { a.self(), factor, number<A>(0.0), number<A>(0.0), number<A>(0.0) };
+        }
+
+        template<typename A>
+        constexpr auto translate(node<A> const& a, number<A> ox, number<A> oy, number<A> oz = number<A>(0.0)) -> transform_node<A> {
+            return transform_node<A> { a.self(), number<A>(1.0), ox, oy, oz };
+        }
+
+        template<typename A, typename WX, typename WY>
+        constexpr auto warp(node<A> const& a, node<WX> const& wx, node<WY> const& wy, number<A> strength) -> warp_node<A, WX, WY> {
+            return warp_node<A, WX, WY> { a.self(), wx.self(), wy.self(), strength };
+        }
+
+        // Fractal sums of an expression, with the octaves described as in `db::fractal`.
+
+        template<typename A>
+        constexpr auto fbm(node<A> const& a, fractal<number<A>> const& f) -> octave_node<A, identity_op> {
+            return octave_node<A, identity_op> { a.self(), f, identity_op {} };
+        }
+
+        template<typename A>
+        constexpr auto ridged(node<A> const& a, fractal<number<A>> const& f) -> octave_node<A, ridge_op> {
+            return octave_node<A, ridge_op> { a.self(), f, ridge_op {} };
+        }
+
+        template<typename A>
+        constexpr auto turbulence(node<A> const& a, fractal<number<A>> const& f) -> octave_node<A, abs_op> {
+            return octave_node<A, abs_op> { a.self(), f, abs_op {} };
+        }
+
+        // Evaluation over grids.
+
+        // Fills `out` (row-major, with `stride` samples between the rows) with the expression at
+        // (x0 + i * step, y0 + j * step), evaluated separately for every sample.
+        template<typename A, typename T>
+        auto fill_2d(node<A> const& a, T* out, long long stride, int width, int height, T x0, T y0, T step) -> void {
+            A const& expr = a.self();
+            for (int j = 0; j < height; ++j) {
+                T* const row = out + j * stride;
+                T const y = y0 + T(j) * step;
+                for (int i = 0; i < width; ++i) {
+                    row[i] = expr(x0 + T(i) * step, y);
+                }
+            }
+        }
+
+        template<typename A, typename T>
+        auto fill_2d(node<A> const& a, T* out, int width, int height, T x0, T y0, T step) -> void {
+            fill_2d(a, out, width, width, height, x0, y0, step);
+        }
+
+        // Fills `out` (`width * height * depth` samples, x-major) with the expression at
+        // (x0 + i * step, y0 + j * step, z0 + k * step).
+        template<typename A, typename T>
+        auto fill_3d(node<A> const& a, T* out, int width, int height, int depth, T x0, T y0, T z0, T step) -> void {
+            A const& expr = a.self();
+            for (int k = 0; k < depth; ++k) {
+                T const z = z0 + T(k) * step;
+                for (int j = 0; j < height; ++j) {
+                    T* const row = out + (static_cast<long long>(k) * height + j) * width;
+                    T const y = y0 + T(j) * step;
+                    for (int i = 0; i < width; ++i) {
+                        row[i] = expr(x0 + T(i) * step, y, z);
+                    }
+                }
+            }
+        }
+
+        // Same as `fill_2d`, but with the grid split into tiles and spread over the threads of the
+        // engine. The coordinates are computed from the indices within the whole grid, so the
+        // samples are identical to those of `fill_2d`.
+        template<typename A, typename T>
+        auto generate(noise_engine& engine, node<A> const& a, T* out, int width, int height, T x0, T y0, T step) -> void {
+            A const& expr = a.self();
+            engine.for_each_tile(width, height, [&](int x, int y, int w, int h) {
+                for (int j = y; j < y + h; ++j) {
+                    T* const row = out + static_cast<long long>(j) * width;
+                    T const sy = y0 + T(j) * step;
+                    for (int i = x; i < x + w; ++i) {
+                        row[i] = expr(x0 + T(i) * step, sy);
+                    }
+                }
+            });
+        }
+    }
+}
+
+#endif // DB_PERLIN_GRAPH_HPP
+
+/*
+MIT License
+
+Copyright (c) 2020-2025 Daniils Buts
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
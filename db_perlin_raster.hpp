@@ -0,0 +1,330 @@
+/*
+ * db-perlin - see license at the bottom, no warranty implied, use at your own risk;
+ *     made by daniilsjb (https://github.com/daniilsjb/perlin-noise)
+ *
+ * The following is a streaming exporter of noise maps to image files. The image is generated
+ * in bands of rows by a noise engine and written to the file as soon as each band is ready, so
+ * only a couple of bands are ever held in memory, and the image may be much larger than the
+ * available RAM. Each band is written from a background thread while the engine generates the
+ * next one into a second buffer, so the disk and the processor are kept busy at the same time.
+ *
+ * The supported formats are 8-bit grayscale BMP, 8-bit and 16-bit binary PGM, and headerless
+ * files of 8-bit, 16-bit, or 32-bit floating-point samples (the latter are common for
+ * heightmaps). The integer formats map the range of values [low, high] linearly onto the full
+ * range of the samples, whereas floating-point samples are written as is.
+ *
+ * The bands are aligned to the tiles of the engine, so the samples are identical to those that
+ * `noise_engine::generate` would produce for the whole region at once.
+ *
+ * Usage:
+ *
+ * This header follows the same conventions as db_perlin.hpp, and must be included after both it
+ * and db_perlin_engine.hpp:
+ *
+ * ```cpp
+ * #define DB_PERLIN_IMPL
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_engine.hpp"
+ * #include "db_perlin_raster.hpp"
+ * ```
+ *
+ * Describe the region as for the engine, pick the format, and pass the path of the file:
+ *
+ * ```cpp
+ * db::noise_region<float> region {};
+ * region.width = 65536;
+ * region.height = 65536;
+ * region.scale = 1.0f / 256.0f;
+ * region.octaves = 8;
+ *
+ * db::raster_options<float> options {};
+ * options.format = db::raster_format::pgm16;
+ *
+ * db::noise_engine engine {};
+ * bool const ok = db::write_raster("heightmap.pgm", engine, region, options);
+ * ```
+ *
+ * The functions return false if the file could not be written, or if the image does not fit into
+ * the format (BMP files are limited to 4 GiB). Files are written strictly sequentially, so the
+ * overload taking a `std::FILE*` may also be used with pipes.
+ */
+
+#ifndef DB_PERLIN_RASTER_HPP
+#define DB_PERLIN_RASTER_HPP
+
+#ifndef DB_PERLIN_ENGINE_HPP
+#error "Please, include db_perlin_engine.hpp before db_perlin_raster.hpp"
+#endif
+
+#include <cstdio>
+
+namespace db {
+    enum class raster_format {
+        bmp,    // 8-bit grayscale BMP, stored top-down with a grayscale palette.
+        pgm8,   // 8-bit binary PGM (P5).
+        pgm16,  // 16-bit binary PGM (P5), big-endian as required by the format.
+        raw8,   // Headerless 8-bit samples.
+        raw16,  // Headerless 16-bit little-endian samples.
+        raw32f, // Headerless 32-bit little-endian floats, written without remapping.
+    };
+
+    template<typename T>
+    struct raster_options {
+        raster_format format = raster_format::bmp;
+        T low = T(-1.0);     // The value mapped to black in the integer formats.
+        T high = T(1.0);     // The value mapped to white in the integer formats.
+        int band_height = 0; // The number of rows per band (zero picks it automatically).
+    };
+
+    template<typename T>
+    auto write_raster(std::FILE* file, noise_engine& engine, noise_region<T> const& region, raster_options<T> const& options = raster_options<T> {}) -> bool;
+
+    template<typename T>
+    auto write_raster(char const* path, noise_engine& engine, noise_region<T> const& region, raster_options<T> const& options = raster_options<T> {}) -> bool;
+}
+
+#ifdef DB_PERLIN_IMPL
+
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <vector>
+
+namespace db {
+    // Bands hold about 4 million samples by default, which keeps the writes large while the two
+    // buffers of doubles take up 64 MiB at most.
+    static constexpr long long raster_band_samples = 1 << 22;
+
+    static auto raster_put16le(unsigned char* out, std::uint32_t value) -> void {
+        out[0] = static_cast<unsigned char>(value >> 0);
+        out[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    static auto raster_put32le(unsigned char* out, std::uint32_t value) -> void {
+        out[0] = static_cast<unsigned char>(value >> 0);
+        out[1] = static_cast<unsigned char>(value >> 8);
+        out[2] = static_cast<unsigned char>(value >> 16);
+        out[3] = static_cast<unsigned char>(value >> 24);
+    }
+
+    // The number of bytes per row of the image; rows of BMP files are padded to 4 bytes.
+    static auto raster_row_size(raster_format format, int width) -> long long {
+        switch (format) {
+            case raster_format::bmp:    return (static_cast<long long>(width) + 3) & ~3LL;
+            case raster_format::pgm8:   return width;
+            case raster_format::pgm16:  return static_cast<long long>(width) * 2;
+            case raster_format::raw8:   return width;
+            case raster_format::raw16:  return static_cast<long long>(width) * 2;
+            case raster_format::raw32f: return static_cast<long long>(width) * 4;
+        }
+        return 0;
+    }
+
+    static inline auto raster_header(raster_format format, int width, int height, std::vector<unsigned char>& header) -> bool {
+        if (format == raster_format::bmp) {
+            long long const offset = 14 + 40 + 256 * 4;
+            long long const image_size = raster_row_size(format, width) * height;
+            if (offset + image_size > 0xFFFFFFFFLL) {
+                return false;
+            }
+
+            header.assign(offset, 0);
+            unsigned char* const file_header = header.data();
+            unsigned char* const info_header = file_header + 14;
+            unsigned char* const palette = info_header + 40;
+
+            file_header[0] = 'B';
+            file_header[1] = 'M';
+            raster_put32le(file_header + 2, std::uint32_t(offset + image_size));
+            raster_put32le(file_header + 10, std::uint32_t(offset));
+
+            // A negative height marks the rows as stored top-down, which lets them be written in
+            // the same order as they are generated.
+            raster_put32le(info_header + 0, 40);
+            raster_put32le(info_header + 4, std::uint32_t(width));
+            raster_put32le(info_header + 8, std::uint32_t(-height));
+            raster_put16le(info_header + 12, 1);
+            raster_put16le(info_header + 14, 8);
+            raster_put32le(info_header + 20, std::uint32_t(image_size));
+            raster_put32le(info_header + 32, 256);
+
+            for (int i = 0; i < 256; ++i) {
+                palette[i * 4 + 0] = static_cast<unsigned char>(i);
+                palette[i * 4 + 1] = static_cast<unsigned char>(i);
+                palette[i * 4 + 2] = static_cast<unsigned char>(i);
+            }
+            return true;
+        }
+
+        if (format == raster_format::pgm8 || format == raster_format::pgm16) {
+            char text[64] = {};
+            int const length = std::snprintf(text, sizeof(text), "P5\n%d %d\n%d\n", width, height, (format == raster_format::pgm8) ? 255 : 65535);
+            header.assign(text, text + length);
+            return true;
+        }
+
+        header.clear();
+        return true;
+    }
+
+    // Converts a band of samples into the bytes of the file.
+    template<typename T>
+    static auto raster_encode(raster_options<T> const& options, T const* samples, int width, int rows, unsigned char* out) -> void {
+        long long const row_size = raster_row_size(options.format, width);
+        T const scale = T(1.0) / (options.high - options.low);
+
+        for (int j = 0; j < rows; ++j) {
+            T const* const row = samples + static_cast<long long>(j) * width;
+            unsigned char* const bytes = out + j * row_size;
+
+            if (options.format == raster_format::raw32f) {
+                for (int i = 0; i < width; ++i) {
+                    float const value = float(row[i]);
+                    std::uint32_t bits = 0;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    raster_put32le(bytes + i * 4, bits);
+                }
+                continue;
+            }
+
+            bool const wide = (options.format == raster_format::pgm16 || options.format == raster_format::raw16);
+            T const maximum = wide ? T(65535.0) : T(255.0);
+
+            for (int i = 0; i < width; ++i) {
+                T t = (row[i] - options.low) * scale;
+                t = (t < T(0.0)) ? T(0.0) : (t > T(1.0)) ? T(1.0) : t;
+
+                auto const value = std::uint32_t(t * maximum + T(0.5));
+                if (!wide) {
+                    bytes[i] = static_cast<unsigned char>(value);
+                } else if (options.format == raster_format::pgm16) {
+                    bytes[i * 2 + 0] = static_cast<unsigned char>(value >> 8);
+                    bytes[i * 2 + 1] = static_cast<unsigned char>(value >> 0);
+                } else {
+                    raster_put16le(bytes + i * 2, value);
+                }
+            }
+
+            for (long long i = wide ? width * 2LL : width; i < row_size; ++i) {
+                bytes[i] = 0;
+            }
+        }
+    }
+
+    template<typename T>
+    auto write_raster(std::FILE* file, noise_engine& engine, noise_region<T> const& region, raster_options<T> const& options) -> bool {
+        DB_PERLIN_PROFILE_ZONE("write_raster");
+
+        int const width = region.width;
+        int const height = region.height;
+        if (file == nullptr || width <= 0 || height <= 0) {
+            return false;
+        }
+
+        std::vector<unsigned char> header;
+        if (!raster_header(options.format, width, height, header)) {
+            return false;
+        }
+        if (!header.empty() && std::fwrite(header.data(), 1, header.size(), file) != header.size()) {
+            return false;
+        }
+
+        // Bands start at multiples of the tile size, so every tile has the same origin as when
+        // the whole region is generated at once. Rows wider than the default band still get a
+        // band of one row of tiles.
+        long long band = (options.band_height > 0) ? options.band_height : raster_band_samples / width;
+        band = (band < 1) ? 1 : band;
+        band = (band + engine_tile_size - 1) / engine_tile_size * engine_tile_size;
+        band = (band > height) ? height : band;
+
+        fractal<T> const f { region.octaves, region.lacunarity, region.gain };
+        permutation const& perm = region.generator ? region.generator->table() : default_permutation;
+        long long const row_size = raster_row_size(options.format, width);
+
+        std::vector<T> buffers[2] = {
+            std::vector<T>(static_cast<std::size_t>(band * width)),
+            std::vector<T>(static_cast<std::size_t>(band * width)),
+        };
+        std::vector<unsigned char> bytes(static_cast<std::size_t>(band * row_size));
+
+        std::future<bool> pending;
+        for (int y = 0, b = 0; y < height; y += int(band), ++b) {
+            int const rows = (height - y < band) ? height - y : int(band);
+            T* const samples = buffers[b & 1].data();
+
+            engine.for_each_tile(width, rows, [&](int tx, int ty, int w, int h) {
+                T* const tile = samples + static_cast<long long>(ty) * width + tx;
+                T const x0 = region.x0 + T(tx) * region.scale;
+                T const y0 = region.y0 + T(y + ty) * region.scale;
+                fbm_fill_2d(perm, tile, width, w, h, x0, y0, region.scale, f);
+            });
+
+            // The previous band must be on its way to the file before its bytes are reused; its
+            // samples have already been converted, so the other buffer is free to be filled next.
+            if (pending.valid() && !pending.get()) {
+                return false;
+            }
+
+            pending = std::async(std::launch::async, [&options, &bytes, file, samples, width, rows, row_size] {
+                raster_encode(options, samples, width, rows, bytes.data());
+                auto const size = static_cast<std::size_t>(rows * row_size);
+                return std::fwrite(bytes.data(), 1, size, file) == size;
+            });
+        }
+
+        if (pending.valid() && !pending.get()) {
+            return false;
+        }
+        return std::fflush(file) == 0;
+    }
+
+    template<typename T>
+    auto write_raster(char const* path, noise_engine& engine, noise_region<T> const& region, raster_options<T> const& options) -> bool {
+        std::FILE* const file = std::fopen(path, "wb");
+        if (file == nullptr) {
+            return false;
+        }
+
+        bool const written = write_raster(file, engine, region, options);
+        bool const closed = std::fclose(file) == 0;
+        return written && closed;
+    }
+}
+
+#ifndef DB_PERLIN_HEADER_ONLY
+
+template auto db::write_raster<float>(std::FILE* file, noise_engine& engine, noise_region<float> const& region, raster_options<float> const& options) -> bool;
+template auto db::write_raster<double>(std::FILE* file, noise_engine& engine, noise_region<double> const& region, raster_options<double> const& options) -> bool;
+
+template auto db::write_raster<float>(char const* path, noise_engine& engine, noise_region<float> const& region, raster_options<float> const& options) -> bool;
+template auto db::write_raster<double>(char const* path, noise_engine& engine, noise_region<double> const& region, raster_options<double> const& options) -> bool;
+
+#endif // DB_PERLIN_HEADER_ONLY
+
+#endif // DB_PERLIN_IMPL
+
+#endif // DB_PERLIN_RASTER_HPP
+
+/*
+MIT License
+
+Copyright (c) 2020-2025 Daniils Buts
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
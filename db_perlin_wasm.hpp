@@ -35,10 +35,56 @@
  * #endif
  * ```
  *
+ * The bindings of whole frames (see `NoiseFrame` below) are only compiled in when
+ * db_perlin_engine.hpp and db_perlin_anim.hpp are included before this header as well:
+ *
+ * ```cpp
+ * #define DB_PERLIN_IMPL
+ * #include "db_perlin.hpp"
+ * #include "db_perlin_engine.hpp"
+ * #include "db_perlin_anim.hpp"
+ * #include "db_perlin_wasm.hpp"
+ * ```
+ *
  * In JavaScript code, each overload of the noise function is assigned a unique name in the format
  * of `perlin<n><type>`, where `n` is the number of dimensions and `type` is a short prefix of the
  * template specialization type. For example, `perlin1f` is the 1D noise using `float` numbers,
- * whereas `perlin3d` is the 3D noise using `double` numbers.
+ * whereas `perlin3d` is the 3D noise using `double` numbers. Simplex noise follows the same scheme,
+ * with 4D overloads in addition (e.g., `simplex3f`, `simplex4d`), and so does periodic noise, which
+ * takes the periods after the coordinates (e.g., `periodic2f(x, y, px, py)`).
+ *
+ * Fractal noise follows the same naming scheme (e.g., `fbm2f`, `ridged3d`, `turbulence1f`). These
+ * functions take the coordinates followed by the number of octaves, lacunarity and gain, and sum
+ * up all octaves in a single call, so the boundary between JavaScript and WASM is only crossed once
+ * per sample rather than once per octave.
+ *
+ * To render whole images, avoid calling the module for every sample altogether, and use a
+ * `NoiseFrame` instead. A frame owns buffers for its samples and pixels on the WASM heap, and
+ * generates all of them in a single call:
+ *
+ * ```js
+ * const frame = new Module.NoiseFrame(width, height);
+ * frame.fill2D(x0, y0, step, octaves, lacunarity, gain);
+ *
+ * const values = frame.values(); // Float32Array with width * height samples (row-major).
+ * const pixels = frame.pixels(); // Uint8ClampedArray with the samples as grayscale RGBA pixels.
+ * context.putImageData(new ImageData(pixels, width, height), 0, 0);
+ * ```
+ *
+ * `fill3D` generates a slice of the 3D noise at the given z-coordinate, whereas `fill1D` only
+ * fills the first row of samples (and leaves the pixels untouched). Slices are generated with a
+ * `db::animated_field` on the calling thread, so animating the z-coordinate while the rest of the
+ * arguments stay the same only costs a fraction of a full 3D evaluation per frame. The arrays
+ * returned by `values` and `pixels` are views into the WASM memory rather than copies, so they
+ * must be requested again after every fill, as growing the memory invalidates them. The exception
+ * is `pixels` in builds with pthreads, where the WASM memory is a `SharedArrayBuffer`, which
+ * `ImageData` does not accept: there, it returns a copy of the pixels instead, which may be passed
+ * to `ImageData` all the same. Call `delete` on a frame once it is no longer needed.
+ *
+ * The module may be compiled with WASM SIMD (`-msimd128`), which lets the compiler vectorize the
+ * grid fills. With pthreads enabled (`-pthread`), `fill2D` generates frames on all available
+ * threads, in the same way as with `db::noise_engine`, whereas `fill1D` and `fill3D` always run
+ * on a single thread. See /examples/wasm/ for the exact build commands.
  */
 
 #ifndef DB_PERLIN_WASM_HPP
@@ -55,6 +101,126 @@
 #include <emscripten.h>
 #include <emscripten/bind.h>
 
+// Frames are generated with the engine and the animated field, so they are only available when
+// both of those headers are included as well.
+#if defined(DB_PERLIN_ENGINE_HPP) && defined(DB_PERLIN_ANIM_HPP)
+#define DB_PERLIN_WASM_FRAMES 1
+#endif
+
+#if DB_PERLIN_WASM_FRAMES
+
+#include <emscripten/val.h>
+
+#include <memory>
+#include <vector>
+
+namespace db {
+    class wasm_frame {
+    public:
+        wasm_frame(int width, int height)
+            : m_width { (width < 1) ? 1 : width }
+            , m_height { (height < 1) ? 1 : height }
+            , m_values(std::size_t(m_width) * std::size_t(m_height))
+            , m_pixels(std::size_t(m_width) * std::size_t(m_height) * 4)
+#ifdef __EMSCRIPTEN_PTHREADS__
+            , m_engine { 0 } {}
+#else
+            , m_engine { 1 } {}
+#endif
+
+        auto width() const -> int { return m_width; }
+        auto height() const -> int { return m_height; }
+
+        auto fill1d(float x0, float step, int octaves, float lacunarity, float gain) -> void {
+            fractal<float> const f { octaves, lacunarity, gain };
+            for (int i = 0; i < m_width; ++i) {
+                m_values[std::size_t(i)] = fbm(x0 + float(i) * step, f);
+            }
+        }
+
+        auto fill2d(float x0, float y0, float step, int octaves, float lacunarity, float gain) -> void {
+            noise_region<float> region {};
+            region.width = m_width;
+            region.height = m_height;
+            region.x0 = x0;
+            region.y0 = y0;
+            region.scale = step;
+            region.octaves = octaves;
+            region.lacunarity = lacunarity;
+            region.gain = gain;
+
+            m_engine.generate(region, m_values.data());
+            update_pixels();
+        }
+
+        auto fill3d(float x0, float y0, float z, float step, int octaves, float lacunarity, float gain) -> void {
+            // Consecutive frames of an animation only differ in the z-coordinate, so the field is
+            // kept around and only rebuilt once the view or the fractal changes.
+            field_key const key { x0, y0, step, octaves, lacunarity, gain };
+            if (!m_field || !same_key(key, m_field_key)) {
+                m_field.reset(new animated_field<float> { m_width, m_height, fractal<float> { octaves, lacunarity, gain } });
+                m_field->set_view(x0, y0, step);
+                m_field_key = key;
+            }
+
+            m_field->evaluate(z, m_values.data());
+            update_pixels();
+        }
+
+        auto values() const -> emscripten::val {
+            return emscripten::val(emscripten::typed_memory_view(m_values.size(), m_values.data()));
+        }
+
+        auto pixels() const -> emscripten::val {
+            // Embind exposes bytes as a Uint8Array, whereas ImageData expects a Uint8ClampedArray,
+            // so the same memory is viewed through the latter instead.
+            auto const bytes = emscripten::val(emscripten::typed_memory_view(m_pixels.size(), m_pixels.data()));
+#ifdef __EMSCRIPTEN_PTHREADS__
+            // With pthreads, the memory is a SharedArrayBuffer, which ImageData rejects, so the
+            // pixels are copied into a buffer of their own.
+            return emscripten::val::global("Uint8ClampedArray").new_(bytes);
+#else
+            return emscripten::val::global("Uint8ClampedArray").new_(bytes["buffer"], bytes["byteOffset"], bytes["length"]);
+#endif
+        }
+
+    private:
+        struct field_key {
+            float x0, y0, step;
+            int octaves;
+            float lacunarity, gain;
+        };
+
+        static auto same_key(field_key const& a, field_key const& b) -> bool {
+            return a.x0 == b.x0 && a.y0 == b.y0 && a.step == b.step
+                && a.octaves == b.octaves && a.lacunarity == b.lacunarity && a.gain == b.gain;
+        }
+
+        auto update_pixels() -> void {
+            for (std::size_t i = 0; i < m_values.size(); ++i) {
+                float const t = m_values[i] * 0.5f + 0.5f;
+                float const value = (t < 0.0f) ? 0.0f : (t > 1.0f) ? 255.0f : t * 255.0f;
+
+                auto const brightness = static_cast<unsigned char>(value + 0.5f);
+                m_pixels[i * 4 + 0] = brightness;
+                m_pixels[i * 4 + 1] = brightness;
+                m_pixels[i * 4 + 2] = brightness;
+                m_pixels[i * 4 + 3] = 255;
+            }
+        }
+
+        int m_width;
+        int m_height;
+        std::vector<float> m_values;
+        std::vector<unsigned char> m_pixels;
+        noise_engine m_engine;
+        std::unique_ptr<animated_field<float>> m_field;
+        field_key m_field_key {};
+    };
+}
+
+#endif // DB_PERLIN_WASM_FRAMES
+
 EMSCRIPTEN_BINDINGS(db_perlin) {
     emscripten::function("perlin1f", emscripten::select_overload<float(float)>(&db::perlin));
     emscripten::function("perlin2f", emscripten::select_overload<float(float, float)>(&db::perlin));
@@ -63,6 +229,60 @@ EMSCRIPTEN_BINDINGS(db_perlin) {
     emscripten::function("perlin1d", emscripten::select_overload<double(double)>(&db::perlin));
     emscripten::function("perlin2d", emscripten::select_overload<double(double, double)>(&db::perlin));
     emscripten::function("perlin3d", emscripten::select_overload<double(double, double, double)>(&db::perlin));
+
+    emscripten::function("simplex1f", emscripten::select_overload<float(float)>(&db::simplex));
+    emscripten::function("simplex2f", emscripten::select_overload<float(float, float)>(&db::simplex));
+    emscripten::function("simplex3f", emscripten::select_overload<float(float, float, float)>(&db::simplex));
+    emscripten::function("simplex4f", emscripten::select_overload<float(float, float, float, float)>(&db::simplex));
+
+    emscripten::function("simplex1d", emscripten::select_overload<double(double)>(&db::simplex));
+    emscripten::function("simplex2d", emscripten::select_overload<double(double, double)>(&db::simplex));
+    emscripten::function("simplex3d", emscripten::select_overload<double(double, double, double)>(&db::simplex));
+    emscripten::function("simplex4d", emscripten::select_overload<double(double, double, double, double)>(&db::simplex));
+
+    emscripten::function("periodic1f", emscripten::select_overload<float(float, int)>(&db::perlin_periodic));
+    emscripten::function("periodic2f", emscripten::select_overload<float(float, float, int, int)>(&db::perlin_periodic));
+    emscripten::function("periodic3f", emscripten::select_overload<float(float, float, float, int, int, int)>(&db::perlin_periodic));
+
+    emscripten::function("periodic1d", emscripten::select_overload<double(double, int)>(&db::perlin_periodic));
+    emscripten::function("periodic2d", emscripten::select_overload<double(double, double, int, int)>(&db::perlin_periodic));
+    emscripten::function("periodic3d", emscripten::select_overload<double(double, double, double, int, int, int)>(&db::perlin_periodic));
+
+    emscripten::function("fbm1f", emscripten::select_overload<float(float, int, float, float)>(&db::fbm));
+    emscripten::function("fbm2f", emscripten::select_overload<float(float, float, int, float, float)>(&db::fbm));
+    emscripten::function("fbm3f", emscripten::select_overload<float(float, float, float, int, float, float)>(&db::fbm));
+
+    emscripten::function("fbm1d", emscripten::select_overload<double(double, int, double, double)>(&db::fbm));
+    emscripten::function("fbm2d", emscripten::select_overload<double(double, double, int, double, double)>(&db::fbm));
+    emscripten::function("fbm3d", emscripten::select_overload<double(double, double, double, int, double, double)>(&db::fbm));
+
+    emscripten::function("ridged1f", emscripten::select_overload<float(float, int, float, float)>(&db::ridged));
+    emscripten::function("ridged2f", emscripten::select_overload<float(float, float, int, float, float)>(&db::ridged));
+    emscripten::function("ridged3f", emscripten::select_overload<float(float, float, float, int, float, float)>(&db::ridged));
+
+    emscripten::function("ridged1d", emscripten::select_overload<double(double, int, double, double)>(&db::ridged));
+    emscripten::function("ridged2d", emscripten::select_overload<double(double, double, int, double, double)>(&db::ridged));
+    emscripten::function("ridged3d", emscripten::select_overload<double(double, double, double, int, double, double)>(&db::ridged));
+
+    emscripten::function("turbulence1f", emscripten::select_overload<float(float, int, float, float)>(&db::turbulence));
+    emscripten::function("turbulence2f", emscripten::select_overload<float(float, float, int, float, float)>(&db::turbulence));
+    emscripten::function("turbulence3f", emscripten::select_overload<float(float, float, float, int, float, float)>(&db::turbulence));
+
+    emscripten::function("turbulence1d", emscripten::select_overload<double(double, int, double, double)>(&db::turbulence));
+    emscripten::function("turbulence2d", emscripten::select_overload<double(double, double, int, double, double)>(&db::turbulence));
+    emscripten::function("turbulence3d", emscripten::select_overload<double(double, double, double, int, double, double)>(&db::turbulence));
+
+#if DB_PERLIN_WASM_FRAMES
+    emscripten::class_<db::wasm_frame>("NoiseFrame")
+        .constructor<int, int>()
+        .function("width", &db::wasm_frame::width)
+        .function("height", &db::wasm_frame::height)
+        .function("fill1D", &db::wasm_frame::fill1d)
+        .function("fill2D", &db::wasm_frame::fill2d)
+        .function("fill3D", &db::wasm_frame::fill3d)
+        .function("values", &db::wasm_frame::values)
+        .function("pixels", &db::wasm_frame::pixels);
+#endif
 }
 
 #endif // DB_PERLIN_WASM_HPP
@@ -3,8 +3,24 @@
  * the following command in this directory:
  *
  *   em++ db_perlin.cpp -o static/db_perlin.js -lembind -O3
+ *
+ * The following flags may be added to the command to make the module faster in
+ * browsers (and runtimes) that support the corresponding WASM features:
+ *
+ *   -msimd128                   Vectorizes the noise with WASM SIMD instructions.
+ *   -pthread -sPTHREAD_POOL_SIZE=navigator.hardwareConcurrency
+ *                               Generates 2D frames on several threads (3D frames are
+ *                               still generated on one). Pages using such a module must
+ *                               be served with the Cross-Origin-Opener-Policy and
+ *                               Cross-Origin-Embedder-Policy headers.
+ *
+ * The module may also be tested locally with Node.js, without a browser:
+ *
+ *   node node.js
  */
 
 #define DB_PERLIN_IMPL
 #include "../../db_perlin.hpp"
+#include "../../db_perlin_engine.hpp"
+#include "../../db_perlin_anim.hpp"
 #include "../../db_perlin_wasm.hpp"
@@ -0,0 +1,53 @@
+/*
+ * Checks the WASM module under Node.js, and measures how long it takes to render a frame
+ * with a single call into the module compared to a call per sample. Compile the module first
+ * (see db_perlin.cpp), then run:
+ *
+ *   node node.js
+ */
+
+const Module = require("./static/db_perlin.js");
+
+Module.onRuntimeInitialized = () => {
+  const w = 400, h = 400;
+  const octaves = 6, lacunarity = 2, gain = 0.5;
+  const x0 = -6.25, y0 = -6.25, step = 1 / 32;
+
+  const frame = new Module.NoiseFrame(w, h);
+
+  let start = performance.now();
+  frame.fill2D(x0, y0, step, octaves, lacunarity, gain);
+  const frameTime = performance.now() - start;
+
+  const values = frame.values();
+  const pixels = frame.pixels();
+
+  start = performance.now();
+  let maxError = 0;
+  for (let y = 0; y < h; ++y) {
+    for (let x = 0; x < w; ++x) {
+      const expected = Module.fbm2f(x0 + x * step, y0 + y * step, octaves, lacunarity, gain);
+      maxError = Math.max(maxError, Math.abs(expected - values[y * w + x]));
+    }
+  }
+  const sampleTime = performance.now() - start;
+
+  // Slices of the 3D noise are summed up in a different order, so they only match up to rounding.
+  const z = 0.3;
+  frame.fill3D(x0, y0, z, step, octaves, lacunarity, gain);
+  const slice = frame.values();
+  let maxError3D = 0;
+  for (let y = 0; y < h; ++y) {
+    for (let x = 0; x < w; ++x) {
+      const expected = Module.fbm3f(x0 + x * step, y0 + y * step, z, octaves, lacunarity, gain);
+      maxError3D = Math.max(maxError3D, Math.abs(expected - slice[y * w + x]));
+    }
+  }
+
+  console.log(`values: ${values.constructor.name}(${values.length}), pixels: ${pixels.constructor.name}(${pixels.length})`);
+  console.log(`frame: ${frameTime.toFixed(2)} ms, per-sample calls: ${sampleTime.toFixed(2)} ms`);
+  console.log(`max difference from per-sample calls: ${maxError} (2D), ${maxError3D} (3D)`);
+
+  frame.delete();
+  process.exit(maxError < 1e-5 && maxError3D < 1e-4 ? 0 : 1);
+};
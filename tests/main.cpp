@@ -0,0 +1,594 @@
+/*
+ * Correctness checks of the noise functions.
+ *
+ * This program checks the guarantees that the documentation of the library makes about its
+ * results, which are easy to break with an optimization that looks harmless. Among others, grid
+ * fills, SIMD kernels, baked tables, noise graphs, and asynchronous chunks produce exactly the
+ * same samples as the scalar calls; derivatives, animated fields, and progressive fBm stay close
+ * to what they approximate; the engine and the tile cache produce the same output regardless of
+ * the number of threads; and periodic noise repeats with exactly the requested period. Each
+ * failed check is printed to the standard error, and the program exits with a non-zero status
+ * if any of them fails:
+ *
+ *   db_perlin_tests
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#define DB_PERLIN_IMPL
+#include "../db_perlin.hpp"
+#include "../db_perlin_engine.hpp"
+#include "../db_perlin_anim.hpp"
+#include "../db_perlin_async.hpp"
+#include "../db_perlin_cache.hpp"
+#include "../db_perlin_graph.hpp"
+#include "../db_perlin_raster.hpp"
+
+static int failures = 0;
+
+// A small deterministic generator, so the sampled points are the same on every platform.
+static auto next_random(std::uint32_t& state) -> std::uint32_t {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+static auto check(bool ok, char const* type, char const* what) -> void {
+    if (!ok) {
+        std::fprintf(stderr, "FAILED (%s): %s\n", type, what);
+        ++failures;
+    }
+}
+
+template<typename T>
+static auto same(std::vector<T> const& a, std::vector<T> const& b) -> bool {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+// A coordinate within [-100, 100], away from the lattice points.
+template<typename T>
+static auto random_coordinate(std::uint32_t& state) -> T {
+    return T(int(next_random(state) % 2000000u) - 1000000) / T(10007.0);
+}
+
+template<typename T>
+static auto test_fills(char const* type) -> void {
+    auto const width = 131;
+    auto const height = 67;
+    auto const depth = 9;
+    auto const x0 = T(-3.7);
+    auto const y0 = T(12.25);
+    auto const z0 = T(0.4);
+    auto const step = T(1.0 / 17.0);
+
+    std::vector<T> fill(static_cast<std::size_t>(width * height * depth));
+    std::vector<T> scalar(fill.size());
+
+    db::perlin_fill_2d(fill.data(), width, height, x0, y0, step);
+    for (auto j = 0; j < height; ++j) {
+        for (auto i = 0; i < width; ++i) {
+            scalar[static_cast<std::size_t>(j * width + i)] = db::perlin(x0 + T(i) * step, y0 + T(j) * step);
+        }
+    }
+    check(std::memcmp(fill.data(), scalar.data(), sizeof(T) * width * height) == 0, type, "perlin_fill_2d differs from perlin");
+
+    db::perlin_fill_3d(fill.data(), width, height, depth, x0, y0, z0, step);
+    for (auto k = 0; k < depth; ++k) {
+        for (auto j = 0; j < height; ++j) {
+            for (auto i = 0; i < width; ++i) {
+                scalar[static_cast<std::size_t>((k * height + j) * width + i)] = db::perlin(x0 + T(i) * step, y0 + T(j) * step, z0 + T(k) * step);
+            }
+        }
+    }
+    check(same(fill, scalar), type, "perlin_fill_3d differs from perlin");
+
+    db::perlin_generator const generator { 0x5eedULL };
+    generator.perlin_fill_2d(fill.data(), width, height, x0, y0, step);
+    for (auto j = 0; j < height; ++j) {
+        for (auto i = 0; i < width; ++i) {
+            scalar[static_cast<std::size_t>(j * width + i)] = generator.perlin(x0 + T(i) * step, y0 + T(j) * step);
+        }
+    }
+    check(std::memcmp(fill.data(), scalar.data(), sizeof(T) * width * height) == 0, type, "perlin_generator::perlin_fill_2d differs from perlin");
+}
+
+static auto test_fixed() -> void {
+    // Only the position within the 256 units of the lattice matters, so origins and steps of
+    // any magnitude must give the same samples as their remainders (all values here are exact).
+    auto const width = 97;
+    auto const height = 41;
+    auto const depth = 5;
+
+    std::vector<std::uint16_t> expected(static_cast<std::size_t>(width * height * depth));
+    std::vector<std::uint16_t> actual(expected.size());
+
+    db::perlin_fill_2d_u16(expected.data(), width, height, 0.25, 3.5, 0.0625);
+    db::perlin_fill_2d_u16(actual.data(), width, height, 3.0e9 + 0.25, -1.0e12 + 3.5, 281474976710656.0 + 0.0625);
+    check(std::memcmp(actual.data(), expected.data(), sizeof(std::uint16_t) * width * height) == 0, "fixed", "perlin_fill_2d_u16 depends on whole multiples of 256");
+
+    db::perlin_fill_3d_u16(expected.data(), width, height, depth, 0.25, 3.5, -7.75, -0.0625);
+    db::perlin_fill_3d_u16(actual.data(), width, height, depth, -3.0e9 + 0.25, 1.0e12 + 3.5, 248.25, -281474976710656.0 - 0.0625);
+    check(same(actual, expected), "fixed", "perlin_fill_3d_u16 depends on whole multiples of 256");
+}
+
+template<typename T>
+static auto test_fractal(char const* type) -> void {
+    // With a gain of -1, the amplitudes of the octaves cancel out to zero.
+    db::fractal<T> const f { 2, T(2.0), T(-1.0) };
+
+    std::uint32_t state = 777u;
+    bool bounded = true;
+    for (int n = 0; n < 1000; ++n) {
+        T const x = T(int(next_random(state) % 20000u) - 10000) / T(97.0);
+        T const y = T(int(next_random(state) % 20000u) - 10000) / T(97.0);
+        T const values[] = { db::fbm(x, y, f), db::ridged(x, y, f), db::turbulence(x, y, f) };
+        for (T const value : values) {
+            bounded &= std::isfinite(value) && std::fabs(value) <= T(1.0);
+        }
+    }
+
+    std::vector<T> grid(64);
+    db::fbm_fill_2d(grid.data(), 8, 8, T(0.3), T(0.4), T(0.37), f);
+    for (T const value : grid) {
+        bounded &= std::isfinite(value) && std::fabs(value) <= T(1.0);
+    }
+    check(bounded, type, "fractal noise with a negative gain is not finite and within [-1, 1]");
+}
+
+template<typename T>
+static auto test_simd(char const* type) -> void {
+    // An odd number of samples, so that the tails of the vectorized kernels are covered as well.
+    std::size_t const count = 1003;
+    std::vector<T> xs(count), ys(count), zs(count);
+    std::uint32_t state = 2024u;
+    for (std::size_t i = 0; i < count; ++i) {
+        xs[i] = random_coordinate<T>(state);
+        ys[i] = random_coordinate<T>(state);
+        zs[i] = random_coordinate<T>(state);
+    }
+
+    std::vector<T> batch(count), scalar(count);
+
+    db::perlin_n(xs.data(), batch.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        scalar[i] = db::perlin(xs[i]);
+    }
+    check(same(batch, scalar), type, "perlin_n (1D) differs from perlin");
+
+    db::perlin_n(xs.data(), ys.data(), batch.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        scalar[i] = db::perlin(xs[i], ys[i]);
+    }
+    check(same(batch, scalar), type, "perlin_n (2D) differs from perlin");
+
+    db::perlin_n(xs.data(), ys.data(), zs.data(), batch.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        scalar[i] = db::perlin(xs[i], ys[i], zs[i]);
+    }
+    check(same(batch, scalar), type, "perlin_n (3D) differs from perlin");
+
+    db::perlin_generator const generator { 99 };
+    generator.perlin_n(xs.data(), ys.data(), zs.data(), batch.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        scalar[i] = generator.perlin(xs[i], ys[i], zs[i]);
+    }
+    check(same(batch, scalar), type, "perlin_generator::perlin_n differs from perlin");
+}
+
+template<typename T>
+static auto test_derivatives(char const* type) -> void {
+    // Central differences in double precision, with a step small enough for their own error
+    // to stay well below the tolerance.
+    double const h = 1.0 / 4096.0;
+    double const tolerance = 1e-4;
+
+    std::uint32_t state = 31337u;
+    double error = 0.0;
+    bool values = true;
+    for (int n = 0; n < 2000; ++n) {
+        T const x = random_coordinate<T>(state);
+        T const y = random_coordinate<T>(state);
+        T const z = random_coordinate<T>(state);
+
+        auto const d1 = db::perlin_d(x);
+        auto const d2 = db::perlin_d(x, y);
+        auto const d3 = db::perlin_d(x, y, z);
+        values &= std::fabs(d1.value - db::perlin(x)) <= T(1e-6);
+        values &= std::fabs(d2.value - db::perlin(x, y)) <= T(1e-6);
+        values &= std::fabs(d3.value - db::perlin(x, y, z)) <= T(1e-6);
+
+        double const dx = double(x), dy = double(y), dz = double(z);
+        double const e[] = {
+            d1.dx - (db::perlin(dx + h) - db::perlin(dx - h)) / (2.0 * h),
+            d2.dx - (db::perlin(dx + h, dy) - db::perlin(dx - h, dy)) / (2.0 * h),
+            d2.dy - (db::perlin(dx, dy + h) - db::perlin(dx, dy - h)) / (2.0 * h),
+            d3.dx - (db::perlin(dx + h, dy, dz) - db::perlin(dx - h, dy, dz)) / (2.0 * h),
+            d3.dy - (db::perlin(dx, dy + h, dz) - db::perlin(dx, dy - h, dz)) / (2.0 * h),
+            d3.dz - (db::perlin(dx, dy, dz + h) - db::perlin(dx, dy, dz - h)) / (2.0 * h),
+        };
+        for (double const d : e) {
+            error = (std::fabs(d) > error) ? std::fabs(d) : error;
+        }
+    }
+    check(values, type, "perlin_d returns a different value than perlin");
+    check(error <= tolerance, type, "perlin_d differs from finite differences");
+}
+
+template<typename T>
+static auto test_bake(char const* type) -> void {
+    // The tables are evaluated by the compiler, which would reject them outright if the baking
+    // functions stopped being usable in constant expressions.
+    static constexpr auto curve = db::bake_perlin_1d<T, 64>(T(-2.0), T(1.0 / 8.0));
+    static constexpr auto detail = db::bake_fbm_2d<T, 16, 16>(T(0.5), T(-1.0), T(1.0 / 16.0), db::fractal<T> { 3 });
+    static constexpr auto volume = db::bake_fbm_3d<T, 4, 4, 4>(T(0.0), T(0.0), T(0.0), T(1.0 / 4.0), db::fractal<T> { 2 });
+
+    db::fractal<T> const f2 { 2 };
+    db::fractal<T> const f3 { 3 };
+
+    bool equal = true;
+    for (int i = 0; i < 64; ++i) {
+        equal &= curve(i) == db::perlin(T(-2.0) + T(i) * T(1.0 / 8.0));
+    }
+    for (int j = 0; j < 16; ++j) {
+        for (int i = 0; i < 16; ++i) {
+            equal &= detail(i, j) == db::fbm(T(0.5) + T(i) * T(1.0 / 16.0), T(-1.0) + T(j) * T(1.0 / 16.0), f3);
+        }
+    }
+    for (int k = 0; k < 4; ++k) {
+        for (int j = 0; j < 4; ++j) {
+            for (int i = 0; i < 4; ++i) {
+                equal &= volume(i, j, k) == db::fbm(T(i) * T(1.0 / 4.0), T(j) * T(1.0 / 4.0), T(k) * T(1.0 / 4.0), f2);
+            }
+        }
+    }
+    check(equal, type, "baked tables differ from the noise evaluated at runtime");
+}
+
+template<typename T>
+static auto test_anim(char const* type) -> void {
+    auto const width = 53;
+    auto const height = 37;
+    auto const x0 = T(-3.3);
+    auto const y0 = T(8.1);
+    auto const step = T(1.0 / 24.0);
+    db::fractal<T> const f { 4 };
+
+    db::animated_field<T> field { width, height, f };
+    field.set_view(x0, y0, step);
+
+    // The terms are summed up in a different order, so the samples only match up to rounding.
+    T const tolerance = T(16.0) * std::numeric_limits<T>::epsilon();
+
+    std::vector<T> slice(static_cast<std::size_t>(width * height));
+    T error = T(0.0);
+    for (T z = T(-1.5); z < T(1.5); z += T(0.37)) {
+        field.evaluate(z, slice.data());
+        for (int j = 0; j < height; ++j) {
+            for (int i = 0; i < width; ++i) {
+                T const expected = db::fbm(x0 + T(i) * step, y0 + T(j) * step, z, f);
+                T const d = std::fabs(slice[static_cast<std::size_t>(j * width + i)] - expected);
+                error = (d > error) ? d : error;
+            }
+        }
+    }
+    check(error <= tolerance, type, "animated_field differs from fbm");
+}
+
+template<typename T>
+static auto test_progressive(char const* type) -> void {
+    db::fractal<T> const f { 8 };
+    T const thresholds[] = { T(-0.3), T(0.0), T(0.25) };
+    T const tolerance = T(0.01);
+
+    auto const band = [&](T value) {
+        int count = 0;
+        for (T const threshold : thresholds) {
+            count += (value > threshold) ? 1 : 0;
+        }
+        return count;
+    };
+
+    std::uint32_t state = 4242u;
+    bool classified = true;
+    bool within = true;
+    for (int n = 0; n < 5000; ++n) {
+        T const x = random_coordinate<T>(state);
+        T const y = random_coordinate<T>(state);
+        T const z = random_coordinate<T>(state);
+
+        classified &= db::fbm_classify(x, f, thresholds, 3) == band(db::fbm(x, f));
+        classified &= db::fbm_classify(x, y, f, thresholds, 3) == band(db::fbm(x, y, f));
+        classified &= db::fbm_classify(x, y, z, f, thresholds, 3) == band(db::fbm(x, y, z, f));
+
+        within &= std::fabs(db::fbm_progressive(x, f, tolerance) - db::fbm(x, f)) <= tolerance;
+        within &= std::fabs(db::fbm_progressive(x, y, f, tolerance) - db::fbm(x, y, f)) <= tolerance;
+        within &= std::fabs(db::fbm_progressive(x, y, z, f, tolerance) - db::fbm(x, y, z, f)) <= tolerance;
+    }
+    check(classified, type, "fbm_classify differs from comparing fbm with the thresholds");
+    check(within, type, "fbm_progressive is not within the tolerance of fbm");
+}
+
+template<typename T>
+static auto test_simplex(char const* type) -> void {
+    std::uint32_t state = 1999u;
+    bool bounded = true;
+    for (int n = 0; n < 20000; ++n) {
+        T const x = random_coordinate<T>(state);
+        T const y = random_coordinate<T>(state);
+        T const z = random_coordinate<T>(state);
+        T const w = random_coordinate<T>(state);
+
+        T const values[] = { db::simplex(x), db::simplex(x, y), db::simplex(x, y, z), db::simplex(x, y, z, w) };
+        for (T const value : values) {
+            bounded &= value >= T(-1.0) && value <= T(1.0);
+        }
+    }
+    check(bounded, type, "simplex is not within [-1, 1]");
+}
+
+template<typename T>
+static auto test_graph(char const* type) -> void {
+    namespace g = db::graph;
+    db::fractal<T> const f { 5 };
+    auto const terrain = g::fbm(g::perlin<T>(), f);
+
+    std::uint32_t state = 555u;
+    bool equal = true;
+    for (int n = 0; n < 2000; ++n) {
+        T const x = random_coordinate<T>(state);
+        T const y = random_coordinate<T>(state);
+        T const z = random_coordinate<T>(state);
+        equal &= terrain(x, y) == db::fbm(x, y, f);
+        equal &= terrain(x, y, z) == db::fbm(x, y, z, f);
+    }
+    check(equal, type, "graph fbm differs from fbm");
+
+    auto const width = 150;
+    auto const height = 90;
+    auto const x0 = T(-7.5);
+    auto const y0 = T(2.25);
+    auto const step = T(1.0 / 32.0);
+
+    std::vector<T> scalar(static_cast<std::size_t>(width * height));
+    for (int j = 0; j < height; ++j) {
+        for (int i = 0; i < width; ++i) {
+            scalar[static_cast<std::size_t>(j * width + i)] = db::fbm(x0 + T(i) * step, y0 + T(j) * step, f);
+        }
+    }
+
+    std::vector<T> filled(scalar.size());
+    g::fill_2d(terrain, filled.data(), width, height, x0, y0, step);
+    check(same(filled, scalar), type, "graph fill_2d differs from fbm");
+
+    std::vector<T> generated(scalar.size());
+    db::noise_engine engine { 3 };
+    g::generate(engine, terrain, generated.data(), width, height, x0, y0, step);
+    check(same(generated, scalar), type, "graph generate differs from fbm");
+}
+
+template<typename T>
+static auto test_async(char const* type) -> void {
+    db::noise_region<T> region {};
+    region.width = 300;
+    region.height = 170;
+    region.x0 = T(12.5);
+    region.y0 = T(-4.0);
+    region.scale = T(1.0 / 40.0);
+    region.octaves = 4;
+
+    std::vector<T> expected(static_cast<std::size_t>(region.width * region.height));
+    db::noise_engine { 1 }.generate(region, expected.data());
+
+    db::chunk_generator<T> chunks { 2 };
+    auto ticket = chunks.submit(region);
+    db::chunk<T> chunk = ticket.get();
+    check(!chunk.cancelled && same(chunk.samples, expected), type, "chunk_generator differs from noise_engine");
+
+    // A large chunk keeps the only worker busy, so the one behind it is cancelled before it starts.
+    db::chunk_generator<T> single { 1 };
+    db::noise_region<T> large = region;
+    large.width = 2048;
+    large.height = 2048;
+    large.octaves = 8;
+
+    auto busy = single.submit(large, 10);
+    auto waiting = single.submit(region, 0);
+    if (waiting.cancel()) {
+        db::chunk<T> cancelled = waiting.get();
+        check(cancelled.cancelled && cancelled.samples.empty(), type, "a cancelled chunk is not delivered empty and cancelled");
+    }
+    busy.cancel();
+}
+
+static auto test_cache() -> void {
+    db::cache_params params {};
+    params.scale = 1.0f / 16.0f;
+    params.octaves = 3;
+
+    int const size = 32;
+    db::tile_cache cache { nullptr, size, 4 };
+    db::fractal<float> const f { params.octaves, params.lacunarity, params.gain };
+
+    // Tile (tx, ty) at level of detail `lod` starts at (tx, ty) * size * step.
+    auto const expected = [&](int tx, int ty, int lod) {
+        float const step = std::ldexp(params.scale, lod);
+        std::vector<float> samples(static_cast<std::size_t>(size * size));
+        db::fbm_fill_2d(samples.data(), size, size, float(double(tx) * size * step), float(double(ty) * size * step), step, f);
+        return samples;
+    };
+    auto const contents = [&](db::tile_cache::tile const& tile) {
+        return std::vector<float>(tile.data(), tile.data() + size * size);
+    };
+
+    {
+        auto const first = cache.get(params, 5, -3, 1);
+        auto const second = cache.get(params, 5, -3, 1);
+        check(same(contents(first), expected(5, -3, 1)), "cache", "tile_cache generates a different tile");
+        check(first.data() == second.data(), "cache", "tile_cache generates a tile again while it is stored");
+    }
+
+    // More tiles than there are slots, so the first one is evicted and generated again.
+    for (int tx = 0; tx < 8; ++tx) {
+        cache.get(params, tx, 0, 0);
+    }
+    check(same(contents(cache.get(params, 5, -3, 1)), expected(5, -3, 1)), "cache", "tile_cache returns a different tile after eviction");
+
+    std::vector<std::vector<float>> tiles;
+    for (int tx = 0; tx < 12; ++tx) {
+        tiles.push_back(expected(tx, 1, 0));
+    }
+
+    bool consistent[4] = { true, true, true, true };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int n = 0; n < 200; ++n) {
+                int const tx = (n * 7 + t * 3) % 12;
+                auto const tile = cache.get(params, tx, 1, 0);
+                consistent[t] = consistent[t] && same(contents(tile), tiles[static_cast<std::size_t>(tx)]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    check(consistent[0] && consistent[1] && consistent[2] && consistent[3], "cache", "tile_cache returns different tiles to concurrent requests");
+}
+
+template<typename T>
+static auto test_engine(char const* type) -> void {
+    db::perlin_generator const generator { 42 };
+
+    db::noise_region<T> region {};
+    region.width = 333;
+    region.height = 150;
+    region.x0 = T(-20.5);
+    region.y0 = T(7.0);
+    region.scale = T(1.0 / 48.0);
+    region.octaves = 5;
+    region.generator = &generator;
+
+    auto const count = static_cast<std::size_t>(region.width * region.height);
+    std::vector<T> expected(count);
+    db::noise_engine { 1 }.generate(region, expected.data());
+
+    for (unsigned threads = 2; threads <= 5; ++threads) {
+        std::vector<T> actual(count);
+        db::noise_engine engine { threads };
+        engine.generate(region, actual.data());
+        check(same(actual, expected), type, "noise_engine output depends on the number of threads");
+    }
+}
+
+template<typename T>
+static auto test_periodic(char const* type) -> void {
+    int const periods[] = { 1, 2, 3, 7, 10, 255, 256, 257, 300, 512, 1000, 70000 };
+    int const count = sizeof(periods) / sizeof(periods[0]);
+    db::fractal<T> const f { 4 };
+
+    std::uint32_t state = 12345u;
+    auto coordinate = [&] {
+        // Multiples of 1/64, so that shifting them by whole periods is exact.
+        return T(int(next_random(state) % 128000u) - 64000) / T(64.0);
+    };
+
+    bool shifted = true;
+    bool shifted_fbm = true;
+    bool default_period = true;
+    for (int n = 0; n < 20000; ++n) {
+        int const px = periods[n % count];
+        int const py = periods[(n / count) % count];
+        int const pz = periods[(n / count / count) % count];
+        T const x = coordinate();
+        T const y = coordinate();
+        T const z = coordinate();
+
+        shifted &= db::perlin_periodic(x, px) == db::perlin_periodic(x + T(px), px);
+        shifted &= db::perlin_periodic(x, y, px, py) == db::perlin_periodic(x - T(2 * px), y + T(py), px, py);
+        shifted &= db::perlin_periodic(x, y, z, px, py, pz) == db::perlin_periodic(x + T(px), y, z - T(pz), px, py, pz);
+        shifted_fbm &= db::fbm_periodic(x, y, px, py, f) == db::fbm_periodic(x + T(px), y - T(py), px, py, f);
+
+        default_period &= db::perlin_periodic(x, 256) == db::perlin(x);
+        default_period &= db::perlin_periodic(x, y, 256, 256) == db::perlin(x, y);
+        default_period &= db::perlin_periodic(x, y, z, 256, 256, 256) == db::perlin(x, y, z);
+    }
+    check(shifted, type, "perlin_periodic does not repeat with its period");
+    check(shifted_fbm, type, "fbm_periodic does not repeat with its period");
+    check(default_period, type, "perlin_periodic with a period of 256 differs from perlin");
+
+    // Periods above 256 must not repeat any sooner than requested (e.g., every 256 units).
+    for (int const period : { 257, 300, 512, 1000, 70000 }) {
+        for (int const shift : { 128, 256, 768 }) {
+            T difference = T(0.0);
+            for (int n = 0; n < 2000; ++n) {
+                T const x = coordinate();
+                T const y = coordinate();
+                T const d = std::fabs(db::perlin_periodic(x + T(shift), y, period, period) - db::perlin_periodic(x, y, period, period));
+                difference = (d > difference) ? d : difference;
+            }
+            check(difference > T(0.5), type, "perlin_periodic repeats sooner than its period");
+        }
+    }
+}
+
+template<typename T>
+static auto test_raster(char const* type) -> void {
+    // Rows wider than the default band of samples once made the band empty, and the writer
+    // never got past the first row.
+    db::noise_region<T> region {};
+    region.width = (1 << 22) + 100;
+    region.height = 3;
+    region.scale = T(1.0 / 64.0);
+
+    std::FILE* const file = std::tmpfile();
+    if (file == nullptr) {
+        check(false, type, "could not create a temporary file");
+        return;
+    }
+
+    db::raster_options<T> options {};
+    options.format = db::raster_format::raw8;
+
+    db::noise_engine engine { 2 };
+    bool const written = db::write_raster(file, engine, region, options);
+    long const size = (std::fseek(file, 0, SEEK_END) == 0) ? std::ftell(file) : -1;
+    std::fclose(file);
+
+    check(written && size == long(region.width) * region.height, type, "write_raster fails on rows wider than a band");
+}
+
+template<typename T>
+static auto test(char const* type) -> void {
+    test_fills<T>(type);
+    test_simd<T>(type);
+    test_derivatives<T>(type);
+    test_bake<T>(type);
+    test_fractal<T>(type);
+    test_anim<T>(type);
+    test_progressive<T>(type);
+    test_simplex<T>(type);
+    test_graph<T>(type);
+    test_engine<T>(type);
+    test_async<T>(type);
+    test_periodic<T>(type);
+    test_raster<T>(type);
+}
+
+auto main() -> int {
+    test_fixed();
+    test_cache();
+    test<float>("float");
+    test<double>("double");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("All checks passed\n");
+}